@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    PhantomBenchmarks.cpp
+    Created: 17 Oct 2026 23:20:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+
+#include "../src/generators/PhantomLFO.h"
+#include "../src/processor/PhantomVoiceBank.h"
+#include "../src/utils/PhantomUtils.h"
+
+/** The number of samples per block, which matches a common host buffer size. */
+static constexpr int k_blockSize = 64;
+
+/** The number of voices (a whole number of lane groups). */
+static constexpr int k_numVoices = 4 * PhantomVoiceBank::k_laneWidth;
+
+/** The number of blocks every kernel is timed over. */
+static constexpr int k_numBlocks = 1 << 14;
+
+/** The number of times every kernel is timed, of which the fastest is kept. */
+static constexpr int k_numRuns = 7;
+
+/**
+ * Times a kernel over `k_numBlocks` blocks (after as many warm-up blocks) and prints the
+ * time per voice and sample of the fastest of `k_numRuns` runs, which is the least disturbed
+ * by the rest of the system.
+ * @param name The name of the kernel.
+ * @param numVoices The number of voices the kernel advances per block.
+ * @param kernel The function running one block of the kernel.
+ * @returns The time per voice and sample (ns).
+ */
+template <typename Kernel>
+static double runBenchmark(const String& name, int numVoices, Kernel&& kernel)
+{
+    for(int i = 0; i < k_numBlocks; i++)
+        kernel();
+
+    double seconds = std::numeric_limits<double>::max();
+
+    for(int run = 0; run < k_numRuns; run++)
+    {
+        const int64 start = Time::getHighResolutionTicks();
+
+        for(int i = 0; i < k_numBlocks; i++)
+            kernel();
+
+        seconds = jmin(seconds, Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start));
+    }
+
+    const double nanoseconds = 1.0e9 * seconds / ((double) k_numBlocks * numVoices * k_blockSize);
+
+    std::printf("%-36s %7.2f ns per voice-sample\n", name.toRawUTF8(), nanoseconds);
+
+    return nanoseconds;
+}
+
+/**
+ * Fills the bank with the block data the synth writes before running the kernels: phase
+ * deltas around 440 Hz, white noise into the filter and the coefficients of a 1 kHz cutoff.
+ * @param bank The bank to fill.
+ * @param modes The filter mode of every lane.
+ */
+static void fillBank(PhantomVoiceBank& bank, const std::vector<int>& modes)
+{
+    Random rng(1);
+
+    std::vector<float> deltas((size_t) k_blockSize);
+    std::vector<float> noise((size_t) k_blockSize);
+    std::vector<float> gs((size_t) k_blockSize);
+    std::vector<float> hs((size_t) k_blockSize);
+
+    const float sampleRate = 48000.0f;
+    const float g = std::tan(MathConstants<float>::pi * 1000.0f / sampleRate);
+
+    for(int lane = 0; lane < k_numVoices; lane++)
+    {
+        const int mode = modes[(size_t) lane];
+        const bool isLadder = mode == 3;
+
+        /** NOTE: The ladder takes the one-pole gain and its feedback gain (with a feedback of 2) instead. */
+        const float G = g / (1.0f + g);
+        const float resonance = isLadder ? 2.0f : MathConstants<float>::sqrt2;
+        const float h = isLadder ? 1.0f / (1.0f + resonance * G * G * G * G) : 1.0f / (1.0f + resonance * g + g * g);
+
+        for(int i = 0; i < k_blockSize; i++)
+        {
+            deltas[(size_t) i] = (440.0f + (float) lane) / sampleRate * (float) Consts::_WAVETABLE_SIZE;
+            noise[(size_t) i] = rng.nextFloat() * 2.0f - 1.0f;
+            gs[(size_t) i] = isLadder ? G : g;
+            hs[(size_t) i] = h;
+        }
+
+        bank.setFilterMode(lane, mode);
+        bank.setFilterResonance(lane, resonance);
+
+        bank.writeLane(PhantomVoiceBank::PRIMARY_OSC, lane, deltas.data(), k_blockSize);
+        bank.writeLane(PhantomVoiceBank::SECONDARY_OSC, lane, deltas.data(), k_blockSize);
+        bank.writeLane(PhantomVoiceBank::FILTER, lane, noise.data(), k_blockSize);
+        bank.writeLane(PhantomVoiceBank::FILTER_G, lane, gs.data(), k_blockSize);
+        bank.writeLane(PhantomVoiceBank::FILTER_H, lane, hs.data(), k_blockSize);
+    }
+}
+
+/**
+ * Times the phase accumulation of the bank, for every group or lane by lane.
+ * NOTE: The kernels overwrite the deltas with phases, which are read as deltas by the next block.
+ * Their cost doesn't depend on the values, so the bank isn't refilled.
+ */
+static void benchmarkPhases()
+{
+    for(bool isSynced : { false, true })
+    {
+        PhantomVoiceBank bank(k_numVoices, k_blockSize);
+        fillBank(bank, std::vector<int>((size_t) k_numVoices, 0));
+
+        const String sync = isSynced ? "sync on" : "sync off";
+
+        runBenchmark("phases, group (" + sync + ")", k_numVoices, [&]
+        {
+            for(int group = 0; group < bank.getNumGroups(); group++)
+                bank.advancePhases(group, isSynced, k_blockSize);
+        });
+
+        runBenchmark("phases, lane (" + sync + ")", k_numVoices, [&]
+        {
+            for(int lane = 0; lane < k_numVoices; lane++)
+                bank.advanceLanePhases(lane, isSynced, k_blockSize);
+        });
+    }
+}
+
+/**
+ * Times the filter of the bank, for groups holding only state-variable lanes, only ladder
+ * lanes or both, and lane by lane for every mode. The cost of the ladder is printed relative
+ * to the state-variable filter as well, which is the per-voice budget it is held to.
+ * NOTE: The output is filtered again by the next block, and denormals are flushed so the
+ * decaying signal runs at the same speed as the noise.
+ */
+static void benchmarkFilter()
+{
+    const int width = PhantomVoiceBank::k_laneWidth;
+
+    const std::vector<std::pair<String, std::function<int(int)>>> layouts = {
+        { "filter, group (state-variable)", [](int lane) { return lane % 3; } },
+        { "filter, group (ladder)", [](int) { return 3; } },
+        { "filter, group (mixed)", [width](int lane) { return lane % width == 0 ? 3 : 0; } }
+    };
+
+    std::vector<double> groupTimes;
+
+    for(const auto& layout : layouts)
+    {
+        std::vector<int> modes;
+
+        for(int lane = 0; lane < k_numVoices; lane++)
+            modes.push_back(layout.second(lane));
+
+        PhantomVoiceBank bank(k_numVoices, k_blockSize);
+        fillBank(bank, modes);
+
+        groupTimes.push_back(runBenchmark(layout.first, k_numVoices, [&]
+        {
+            for(int group = 0; group < bank.getNumGroups(); group++)
+                bank.filter(group, k_blockSize);
+        }));
+    }
+
+    const StringArray modeNames = { "low-pass", "band-pass", "high-pass", "ladder" };
+    std::vector<double> laneTimes;
+
+    for(int mode = 0; mode < modeNames.size(); mode++)
+    {
+        PhantomVoiceBank bank(k_numVoices, k_blockSize);
+        fillBank(bank, std::vector<int>((size_t) k_numVoices, mode));
+
+        laneTimes.push_back(runBenchmark("filter, lane (" + modeNames[mode] + ")", k_numVoices, [&]
+        {
+            for(int lane = 0; lane < k_numVoices; lane++)
+                bank.filterLane(lane, mode, k_blockSize);
+        }));
+    }
+
+    std::printf("%-36s %7.2fx (group), %.2fx (lane)\n", "filter, ladder / state-variable", groupTimes[1] / groupTimes[0], laneTimes[3] / laneTimes[0]);
+}
+
+/**
+ * Times the LFO for a wavetable shape, the noise shape and a shape that changes every block
+ * (which keeps the cross-fade running), at audio rate and at the default control rate.
+ */
+static void benchmarkLFO()
+{
+    const std::vector<std::pair<String, std::pair<int, int>>> shapes = {
+        { "sine", { 0, 0 } },
+        { "noise", { 4, 4 } },
+        { "fading", { 0, 1 } }
+    };
+
+    for(int interval : { 1, 32 })
+    {
+        for(const auto& shape : shapes)
+        {
+            PhantomLFO lfo;
+            lfo.setControlInterval(interval);
+
+            PhantomLFOParameters parameters;
+            parameters.rate = 5.37f;
+
+            std::vector<float> values((size_t) k_blockSize);
+            int block = 0;
+
+            runBenchmark("lfo, " + shape.first + " (interval " + String(interval) + ")", 1, [&]
+            {
+                parameters.shape = (float) (block++ % 2 == 0 ? shape.second.first : shape.second.second);
+
+                lfo.update(parameters, 48000.0f);
+                lfo.evaluate(values.data(), k_blockSize);
+            });
+        }
+    }
+}
+
+/**
+ * Times the kernels that run for every voice and sample and prints the time each takes per
+ * voice and sample (a whole voice has about 300 ns per sample when all 68 voices play at
+ * 48 kHz on one core).
+ */
+int main(int argc, char* argv[])
+{
+    ignoreUnused(argc, argv);
+
+    ScopedNoDenormals noDenormals;
+
+    std::printf("%d voices, %d lanes per group, %d samples per block\n\n", k_numVoices, PhantomVoiceBank::k_laneWidth, k_blockSize);
+
+    benchmarkPhases();
+    benchmarkFilter();
+    benchmarkLFO();
+
+    return 0;
+}
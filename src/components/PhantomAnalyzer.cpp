@@ -75,15 +75,10 @@ void PhantomAnalyzerComponent::timerCallback()
     repaint();
 }
 
-void PhantomAnalyzerComponent::pushBuffer(AudioSampleBuffer& buffer) noexcept
+void PhantomAnalyzerComponent::pushSamples(const float* samples, int numSamples) noexcept
 {
-    if(buffer.getNumChannels() > 0)
-    {
-        const float* channelData = buffer.getReadPointer(0);
-
-        for(int i = 0; i < buffer.getNumSamples(); i++)
-            pushNextSample(channelData[i]);
-    }
+    for(int i = 0; i < numSamples; i++)
+        pushNextSample(samples[i]);
 }
 
 inline void PhantomAnalyzerComponent::pushNextSample(float sample) noexcept
@@ -35,14 +35,14 @@ public:
 
     /**
      * Inserts data into the buffer to use for the display.
-     * CAUTION: This method is called from within the audio thread so it must be real-time safe.
-     * @param buffer A reference to the buffer data that will be inserted.
+     * NOTE: This is called on the message thread with samples pulled from the processor's audio tap.
+     * @param samples The sample values to insert.
+     * @param numSamples The number of sample values.
      */
-    void pushBuffer(AudioSampleBuffer& buffer) noexcept;
+    void pushSamples(const float* samples, int numSamples) noexcept;
 
     /**
      * Inserts single sample point into the buffer.
-     * CAUTION: This method is called from within the audio thread so it must be real-time safe.
      * @param sample The sample point value, ideally in the range of [-1.0f, 1.0f].
      */
     inline void pushNextSample(float sample) noexcept;
@@ -35,8 +35,6 @@ void PhantomOscilloscopeComponent::init()
 
 void PhantomOscilloscopeComponent::paint(Graphics& graphics)
 {
-    m_isPainting = true;
-
     graphics.fillAll(Colours::transparentBlack);
 
     const int numSamples = m_buffer->getNumSamples();
@@ -67,8 +65,6 @@ void PhantomOscilloscopeComponent::paint(Graphics& graphics)
         graphics.setColour(Consts::_SECONDARY_COLOUR);
         graphics.drawLine(x1, y1, x2, y2, k_strokeWidth);
     }
-
-    m_isPainting = false;
 }
 
 void PhantomOscilloscopeComponent::resized()
@@ -81,16 +77,18 @@ void PhantomOscilloscopeComponent::timerCallback()
     repaint();
 }
 
-void PhantomOscilloscopeComponent::pushBuffer(AudioBuffer<float>& buffer)
+void PhantomOscilloscopeComponent::pushSamples(const float* samples, int numSamples) noexcept
 {
-    if(m_isPainting)
-        return;
+    while(numSamples > 0)
+    {
+        const int numToCopy = jmin(numSamples, k_bufferSize - (int) m_bufferIdx);
 
-    const float* reader = buffer.getReadPointer(0, 0);
-    const int numToCopy = buffer.getNumSamples();
+        m_buffer->copyFrom(0, m_bufferIdx, samples, numToCopy);
 
-    m_buffer->copyFrom(0, m_bufferIdx, reader, numToCopy);
+        m_bufferIdx += numToCopy;
+        m_bufferIdx %= k_bufferSize;
 
-    m_bufferIdx += numToCopy;
-    m_bufferIdx %= k_bufferSize;
+        samples += numToCopy;
+        numSamples -= numToCopy;
+    }
 }
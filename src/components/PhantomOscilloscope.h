@@ -35,9 +35,11 @@ public:
 
     /**
      * Inserts data into the buffer to use for the display.
-     * @param buffer A reference to the buffer data that will be inserted.
+     * NOTE: This is called on the message thread with samples pulled from the processor's audio tap.
+     * @param samples The sample values to insert.
+     * @param numSamples The number of sample values.
      */
-    void pushBuffer(AudioBuffer<float>& buffer);
+    void pushSamples(const float* samples, int numSamples) noexcept;
 
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomOscilloscopeComponent)
@@ -45,8 +47,7 @@ private:
     /** The unique pointer to the buffer containing samples for the oscilloscope. */
     std::unique_ptr<AudioBuffer<float>> m_buffer;
 
-
-    /** The current buffer position, which is atomic since it is updated by the audio thread and read by the GUI thread. */
+    /** The current buffer position. */
     unsigned int m_bufferIdx = 0;
 
     /** The buffer size to use in containing sample data. */
@@ -54,9 +55,6 @@ private:
 
     /** The width of the stroke to use in painting the samples. */
     const float k_strokeWidth = 1.8f;
-
-    /** Lock for when the component is painting the samples. */
-    bool m_isPainting = false;
 };
 
 #endif
@@ -69,6 +69,9 @@ PhantomAudioProcessorEditor::PhantomAudioProcessorEditor(PhantomAudioProcessor&
 
 PhantomAudioProcessorEditor::~PhantomAudioProcessorEditor()
 {
+    stopTimer();
+    m_processor.getAudioTap().setReaderAttached(false);
+
     m_phantomAmplifier = nullptr;
     m_phantomOscillators = nullptr;
     m_phantomPhasors = nullptr;
@@ -104,6 +107,21 @@ void PhantomAudioProcessorEditor::init()
 
     m_openGlContext.setComponentPaintingEnabled(true);
     m_openGlContext.attachTo(*this);
+
+    m_processor.getAudioTap().setReaderAttached(true);
+    startTimerHz(60);
+}
+
+void PhantomAudioProcessorEditor::timerCallback()
+{
+    PhantomAudioTap& audioTap = m_processor.getAudioTap();
+
+    int numSamples;
+    while((numSamples = audioTap.pull(m_tapSamples, numElementsInArray(m_tapSamples))) > 0)
+    {
+        m_phantomOscilloscope->pushSamples(m_tapSamples, numSamples);
+        m_phantomAnalyzer->pushSamples(m_tapSamples, numSamples);
+    }
 }
 
 void PhantomAudioProcessorEditor::reset()
@@ -29,7 +29,8 @@ typedef AudioProcessorValueTreeState::SliderAttachment SliderAttachment;
  * The editor component holding most of the code responsible for the
  * GUI (sliders, buttons, text, etc.).
  */
-class PhantomAudioProcessorEditor : public AudioProcessorEditor
+class PhantomAudioProcessorEditor : public AudioProcessorEditor,
+                                    private Timer
 {
 public:
     PhantomAudioProcessorEditor(PhantomAudioProcessor& p, AudioProcessorValueTreeState& vts);
@@ -54,22 +55,18 @@ public:
      */
     void reset();
 
-    /**
-     * The unique pointer to the analyzer, used by the processor.
-     */
-    std::unique_ptr<PhantomAnalyzerComponent> m_phantomAnalyzer;
-
-    /**
-     * The unique pointer to the oscilloscope, used by the processor.
-     */
-    std::unique_ptr<PhantomOscilloscopeComponent> m_phantomOscilloscope;
-
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomAudioProcessorEditor)
 
     /** Initializes the editor component. */
     void init();
 
+    /**
+     * Called when the timer hits zero, pulls the processor's output from the audio tap 
+     * and pushes it to the visualizers.
+     */
+    void timerCallback() override;
+
     /**
      * This reference is provided as a quick way for your editor to
      * access the processor object that created it.
@@ -104,6 +101,21 @@ private:
     std::unique_ptr<PhantomEnvelopeComponent> m_phantomModEg;
     std::unique_ptr<PhantomPresetComponent> m_phantomPreset;
 
+    /**
+     * The unique pointer to the analyzer, fed from the processor's audio tap.
+     */
+    std::unique_ptr<PhantomAnalyzerComponent> m_phantomAnalyzer;
+
+    /**
+     * The unique pointer to the oscilloscope, fed from the processor's audio tap.
+     */
+    std::unique_ptr<PhantomOscilloscopeComponent> m_phantomOscilloscope;
+
+    /**
+     * The samples pulled from the audio tap on each timer callback.
+     */
+    float m_tapSamples[1 << 10];
+
     /** 
      * A constant-value screen ratio to use for the GUI.
      */
@@ -235,6 +235,10 @@ String PhantomLookAndFeel::getSliderReadout(Slider& slider, StringArray& nameTok
             case 2:
                 readout = "HPF";
                 break;
+
+            case 3:
+                readout = "LAD";
+                break;
         }
     }
     else if(nameTokens[3].equalsIgnoreCase("SHAPE") && nameTokens[1].equalsIgnoreCase("LFO"))
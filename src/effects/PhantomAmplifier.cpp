@@ -12,26 +12,53 @@
 
 #include "../utils/PhantomUtils.h"
 
-PhantomAmplifier::PhantomAmplifier(AudioProcessorValueTreeState& vts) : m_parameters(vts)
+PhantomAmplifier::PhantomAmplifier()
 {
-    p_level = m_parameters.getRawParameterValue(Consts::_LEVEL_PARAM_ID);
+    m_smoother.reset(new PhantomSmoother());
+    m_smoother->add(m_gain, m_gainRamp, Consts::_PARAM_SMOOTHING_TIME, PhantomSmoother::MULTIPLICATIVE);
 }
 
 PhantomAmplifier::~PhantomAmplifier()
 {
-    p_level = nullptr;
+    m_smoother = nullptr;
+}
+
+void PhantomAmplifier::prepare(float sampleRate, int samplesPerBlock)
+{
+    m_smoother->prepare(sampleRate, samplesPerBlock);
+}
+
+void PhantomAmplifier::update(const PhantomAmplifierParameters& parameters) noexcept
+{
+    m_parameters = parameters;
+    m_gain = powf(2.0f, m_parameters.level / 6.0f);
 }
 
 void PhantomAmplifier::apply(AudioBuffer<float>& buffer) noexcept
 {
-    float gain = powf(2, *p_level / 6);
-    if(gain != m_previousGain)
-    {
-        buffer.applyGainRamp(0, buffer.getNumSamples(), m_previousGain, gain);
-        m_previousGain = gain;
-    }
-    else 
+    if(m_smoother->getMaxNumSamples() == 0)
+        return;
+
+    int startSample = 0;
+    int numSamples = buffer.getNumSamples();
+
+    /** NOTE: Hosts may pass larger blocks than announced, so the buffer is smoothed in chunks. */
+    while(numSamples > 0)
     {
-        buffer.applyGain(gain);
+        const int numToApply = jmin(numSamples, m_smoother->getMaxNumSamples());
+        m_smoother->process(numToApply);
+
+        if(m_gainRamp.isSmoothing)
+        {
+            for(int channel = 0; channel < buffer.getNumChannels(); channel++)
+                FloatVectorOperations::multiply(buffer.getWritePointer(channel, startSample), m_gainRamp.values, numToApply);
+        }
+        else
+        {
+            buffer.applyGain(startSample, numToApply, m_gainRamp.value);
+        }
+
+        startSample += numToApply;
+        numSamples -= numToApply;
     }
 }
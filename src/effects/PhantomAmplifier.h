@@ -13,17 +13,33 @@
 
 #include "JuceHeader.h"
 
+#include "../utils/PhantomParameters.h"
+#include "../utils/PhantomSmoother.h"
+
 /**
- * The audio component that applies a gain (ramped as necessary)
+ * The audio component that applies a gain (smoothed as necessary)
  * to an audio buffer.
  */
 class PhantomAmplifier
 {
 public:
     
-    PhantomAmplifier(AudioProcessorValueTreeState&);
+    PhantomAmplifier();
     ~PhantomAmplifier();
 
+    /**
+     * Prepares the gain smoothing for playback.
+     * @param sampleRate The sample rate to use in smoothing the gain.
+     * @param samplesPerBlock The expected number of samples in a block (audio buffer).
+     */
+    void prepare(float sampleRate, int samplesPerBlock);
+
+    /**
+     * Updates the amplifier's parameters (level).
+     * @param parameters The amplifier's parameter values for the block.
+     */
+    void update(const PhantomAmplifierParameters& parameters) noexcept;
+
     /**
      * Applies the amplifier to the buffer whose reference was
      * passed in.
@@ -34,21 +50,28 @@ public:
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomAmplifier)
     
-    AudioProcessorValueTreeState& m_parameters;
+    /**
+     * The parameter values for the current block.
+     * NOTE: The level is in units of decibels (dB).
+     */
+    PhantomAmplifierParameters m_parameters;
+
+    /**
+     * The unique pointer to the smoother of the gain, for eliminating discontinuities
+     * between buffers.
+     */
+    std::unique_ptr<PhantomSmoother> m_smoother;
 
     /**
-     * The atomic parameter pointer for the amplifier level,
-     * which is in units of decibels (dB).
+     * The gain for the current block, which is smoothed towards.
+     * NOTE: The gain is a linear multiplier, which is different from the level (in decibels).
      */
-    std::atomic<float>* p_level = nullptr;
+    float m_gain = 1.0f;
 
     /**
-     * The previous gain value, useful for eliminating discontinuities
-     * between buffers. 
-     * NOTE: The gain is a float between 0.0f and 1.0f, which is different
-     * from the level (in decibels).
+     * The smoothed gain.
      */
-    float m_previousGain;
+    PhantomRamp m_gainRamp;
 };
 
 #endif
@@ -10,64 +10,165 @@
 
 #include "PhantomFilter.h"
 
+#include "../utils/PhantomMath.h"
 #include "../utils/PhantomUtils.h"
 
-PhantomFilter::PhantomFilter(AudioProcessorValueTreeState& vts, dsp::ProcessSpec& ps) : m_parameters(vts)
+/** The range of the coefficient table, in octaves of the normalized cutoff (`cutoff / sampleRate`). */
+static constexpr float k_tableMinOctave = -16.0f;
+static constexpr float k_tableMaxOctave = -1.1f;
+
+/** The number of points in the coefficient table (one more is held for the interpolation). */
+static constexpr int k_tableSize = 512;
+
+/**
+ * The `g` coefficient (`tan(pi * fc / fs)`) sampled evenly in octaves of the normalized cutoff.
+ * It doesn't depend on the sample rate, so every filter shares it.
+ */
+struct PhantomFilterCoefficientTable
+{
+    PhantomFilterCoefficientTable()
+    {
+        for(int i = 0; i <= k_tableSize; i++)
+        {
+            const float octave = k_tableMinOctave + (k_tableMaxOctave - k_tableMinOctave) * (float) i / (float) k_tableSize;
+            values[i] = std::tan(MathConstants<float>::pi * std::exp2(octave));
+        }
+    }
+
+    float values[k_tableSize + 1];
+};
+
+PhantomFilter::PhantomFilter(dsp::ProcessSpec& ps, const PhantomFilterRamps& ramps) : m_ramps(ramps)
 {
-    m_filter.reset(new dsp::StateVariableTPTFilter<float>());
-    m_filter->prepare(ps);
-    m_filter->setType(dsp::StateVariableTPTFilterType::lowpass);
-    m_filter->snapToZero();
+    m_sampleRate = (float) ps.sampleRate;
+    m_log2SampleRate = std::log2(m_sampleRate);
+    m_cutoffUpperBounds = jmin(k_cutoffUpperBounds, k_maxNormalizedCutoff * m_sampleRate);
 
     m_waveshaper.reset(new PhantomWaveshaper());
 
-    p_cutoff = m_parameters.getRawParameterValue(Consts::_FLTR_CUTOFF_PARAM_ID);
-    p_resonance = m_parameters.getRawParameterValue(Consts::_FLTR_RESO_PARAM_ID);
-    p_drive = m_parameters.getRawParameterValue(Consts::_FLTR_DRIVE_PARAM_ID);
-    p_type = m_parameters.getRawParameterValue(Consts::_FLTR_MODE_PARAM_ID);
-    p_egModDepth = m_parameters.getRawParameterValue(Consts::_FLTR_EG_MOD_DEPTH_PARAM_ID);
-    p_lfoModDepth = m_parameters.getRawParameterValue(Consts::_FLTR_LFO_MOD_DEPTH_PARAM_ID);
-
-    update();
+    update(m_parameters);
 }
 
 PhantomFilter::~PhantomFilter()
 {
-    m_filter = nullptr;
     m_waveshaper = nullptr;
+}
 
-    p_cutoff = nullptr;
-    p_resonance = nullptr;
-    p_drive = nullptr;
-    p_type = nullptr;
-    p_egModDepth = nullptr;
-    p_lfoModDepth = nullptr;
+void PhantomFilter::reset() noexcept
+{
+    m_waveshaper->reset();
+
+    m_numUntilControl = 0;
+    m_isCoefficientSet = false;
 }
 
-void PhantomFilter::update() noexcept
+void PhantomFilter::setControlInterval(int interval) noexcept
 {
-    /**
-     * NOTE: Frequency is not being set here because it is called in the update 
-     * function. Discontinuous numbers could result in artifacts.
-    */
+    m_controlInterval = jmax(1, interval);
+    m_numUntilControl = jmin(m_numUntilControl, m_controlInterval);
+}
+
+void PhantomFilter::update(const PhantomFilterParameters& parameters) noexcept
+{
+    m_parameters = parameters;
+    m_mode = (int) m_parameters.mode;
+}
+
+void PhantomFilter::evaluate(float* samples, float* g, float* h, const float* egMod, const float* lfoMod, int numSamples) noexcept
+{
+    const float* cutoff = m_ramps.cutoff.values;
+    const float* drive = m_ramps.drive.values;
+    const float* egModDepth = m_ramps.egModDepth.values;
+    const float* lfoModDepth = m_ramps.lfoModDepth.values;
+
+    /** NOTE: The resonance is smoothed per block, as the voice bank holds a single coefficient for each lane. */
+    const float resonance = getResonanceCoefficient();
+
+    if(m_ramps.drive.isSmoothing || m_ramps.drive.value != 0.0f)
+        m_waveshaper->htanADAA(samples, drive, numSamples);
+    else
+        m_waveshaper->reset(samples[numSamples - 1]);
+
+    /** NOTE: `g` is looked up at control points and ramped linearly in between. */
+    int sampleIdx = 0;
+
+    while(sampleIdx < numSamples)
+    {
+        if(m_numUntilControl == 0)
+        {
+            const int i = sampleIdx;
+
+            float egScale = egModDepth[i] * (abs(lfoModDepth[i]) * -0.5f + 1.0f);
+            float lfoScale = lfoModDepth[i] * (abs(egModDepth[i]) * -0.5f + 1.0f);
+
+            float mod = egScale * egMod[i] + lfoScale * (lfoMod[i] * 0.5f + 0.5f);
+            float offset = k_cutoffModulationMultiplier * mod;
+
+            float frequency = m_waveshaper->clip(cutoff[i] + offset, k_cutoffLowerBounds, m_cutoffUpperBounds);
+            float target = getCoefficient(frequency);
+
+            if(!m_isCoefficientSet)
+            {
+                m_coefficient = target;
+                m_isCoefficientSet = true;
+            }
+
+            m_coefficientIncrement = (target - m_coefficient) / (float) m_controlInterval;
+            m_coefficientTarget = target;
+            m_numUntilControl = m_controlInterval;
+        }
+
+        const int numToWrite = jmin(numSamples - sampleIdx, m_numUntilControl);
+
+        float coefficient = m_coefficient;
+        for(int i = sampleIdx; i < sampleIdx + numToWrite; i++)
+        {
+            coefficient += m_coefficientIncrement;
+            g[i] = coefficient;
+        }
+
+        m_numUntilControl -= numToWrite;
+        m_coefficient = m_numUntilControl == 0 ? m_coefficientTarget : coefficient;
+        sampleIdx += numToWrite;
+    }
+
+    if(m_mode == k_ladderMode)
+    {
+        for(int i = 0; i < numSamples; i++)
+        {
+            g[i] = g[i] / (1.0f + g[i]);
+
+            const float G2 = g[i] * g[i];
+            h[i] = 1.0f / (1.0f + resonance * G2 * G2);
+        }
+
+        return;
+    }
+
+    for(int i = 0; i < numSamples; i++)
+        h[i] = 1.0f / (1.0f + resonance * g[i] + g[i] * g[i]);
+}
+
+float PhantomFilter::getResonanceCoefficient() const noexcept
+{
+    const float R2 = 1.0f / m_ramps.resonance.value;
+
+    if(m_mode != k_ladderMode)
+        return R2;
 
-    m_filter->setType((dsp::StateVariableTPTFilterType)(int) *p_type);
-    m_filter->setResonance(*p_resonance);
+    /** NOTE: The ladder's feedback starts at the resonance where the state-variable filter is flat (`Q = 1 / sqrt(2)`). */
+    return k_ladderMaxFeedback * jmax(0.0f, 1.0f - R2 * MathConstants<float>::sqrt2 * 0.5f);
 }
 
-float PhantomFilter::evaluate(float sample, float egMod, float lfoMod) noexcept
+float PhantomFilter::getCoefficient(float frequency) const noexcept
 {
-    float envelope = *p_egModDepth * egMod * (abs(*p_lfoModDepth) * -0.5f + 1.0f);
-    float lfo = *p_lfoModDepth * (lfoMod * 0.5f + 0.5f) * (abs(*p_egModDepth) * -0.5f + 1.0f);
-    float mod = envelope + lfo;
-    float offset = k_cutoffModulationMultiplier * mod;
+    static const PhantomFilterCoefficientTable table;
 
-    float frequency = m_waveshaper->clip(*p_cutoff + offset, k_cutoffLowerBounds, k_cutoffUpperCounds);
-    m_filter->setCutoffFrequency((m_previousFrequency + frequency) * 0.5f);
-    m_previousFrequency = frequency;
+    const float octave = PhantomMath::log(frequency) * 1.44269504f - m_log2SampleRate;
+    const float position = jlimit(0.0f, (float) k_tableSize, (octave - k_tableMinOctave) * ((float) k_tableSize / (k_tableMaxOctave - k_tableMinOctave)));
 
-    float distortion = m_waveshaper->htan(*p_drive, sample);
-    sample = (*p_drive * distortion) + ((1.0f - *p_drive) * sample);
+    const int index = jmin((int) position, k_tableSize - 1);
+    const float fraction = position - (float) index;
 
-    return m_filter->processSample(k_channelNumber, sample);
+    return table.values[index] + fraction * (table.values[index + 1] - table.values[index]);
 }
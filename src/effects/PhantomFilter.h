@@ -16,89 +16,124 @@
 #include "JuceHeader.h"
 
 #include "PhantomWaveshaper.h"
+#include "../utils/PhantomParameters.h"
+#include "../utils/PhantomUtils.h"
 
 /**
- * The audio component for filtering real-time audio signals.
+ * The audio component for filtering real-time audio signals, either with the 2-pole
+ * state-variable filter (low-pass, band-pass or high-pass) or with the 4-pole
+ * zero-delay-feedback ladder (low-pass, with saturation in every stage).
  */
 class PhantomFilter
 {
 public:
-    PhantomFilter(AudioProcessorValueTreeState&, dsp::ProcessSpec&);
+    PhantomFilter(dsp::ProcessSpec&, const PhantomFilterRamps&);
     ~PhantomFilter();
 
     /**
-     * Updates the parameters for the filter like resonance, drive, EG/LFO 
-     * mod intensity, etc.).
+     * Resets the state of the drive and the coefficient ramp, for a new note.
      */
-    void update() noexcept;
+    void reset() noexcept;
 
     /**
-     * Filters a sample value.
-     * @param sample The original sample value to filter.
-     * @param egMod The intensity of the envelope generator modulation.
-     * @param lfoMod The intensity of the LFO modulation.
-     * @returns The filtered sample value with resonance, drive, and modulations applied.
+     * Sets the number of samples between the control points of the cutoff, where the `g`
+     * coefficient is looked up (it is ramped linearly in between).
+     * @param interval The number of samples between control points (at least 1).
      */
-    float evaluate(float sample, float egMod, float lfoMod) noexcept;
-
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomFilter)
+    void setControlInterval(int interval) noexcept;
 
     /**
-     * The unique pointer for the JUCE filter used in Phantom's implementation.
+     * Updates the parameters for the filter (mode), the continuous parameters like 
+     * cutoff, resonance, drive and EG/LFO mod intensity are smoothed.
+     * @param parameters The filter's parameter values for the block.
      */
-    std::unique_ptr<dsp::StateVariableTPTFilter<float>> m_filter;
+    void update(const PhantomFilterParameters& parameters) noexcept;
 
     /**
-     * The unique pointer for the waveshaper, useful in driving a filtered signal.
+     * Applies the (anti-aliased) drive to a block of sample values in place and computes the (modulated) coefficients 
+     * of the topology-preserving-transform state-variable filter (or the ladder) for every sample. The filter recursion 
+     * itself is run across voices by the `PhantomVoiceBank`.
+     * @param samples The original sample values, which are overwritten with the driven sample values.
+     * NOTE: The modulated cutoff is only evaluated at the control points, where `g` is read from a
+     * table indexed in octaves of the normalized cutoff, which spares a `tan()` for every sample.
+     * @param g The array to write the `g` coefficient (`tan(pi * fc / fs)`) to, or the ladder's one-pole gain (`g / (1 + g)`).
+     * @param h The array to write the `h` coefficient (`1 / (1 + R2 * g + g * g)`) to, or the ladder's feedback gain
+     * (`1 / (1 + k * G^4)`), which keeps the divisions out of the voice bank's kernels.
+     * @param egMod The intensities of the envelope generator modulation.
+     * @param lfoMod The intensities of the LFO modulation.
+     * @param numSamples The number of sample values to process.
      */
-    std::unique_ptr<PhantomWaveshaper> m_waveshaper;
-
-    AudioProcessorValueTreeState& m_parameters;
+    void evaluate(float* samples, float* g, float* h, const float* egMod, const float* lfoMod, int numSamples) noexcept;
 
     /**
-     * The atomic parameter pointer for the filter's cutoff.
+     * @returns The resonance coefficient of the filter's mode for the (smoothed) resonance (Q) at the end of the
+     * samples being rendered: `R2 = 1 / Q` for the state-variable filter, or the feedback `k` for the ladder.
      */
-    std::atomic<float>* p_cutoff;
+    float getResonanceCoefficient() const noexcept;
 
     /**
-     * The atomic parameter pointer for the filter's resonance.
+     * @returns The filter's mode (0: low-pass, 1: band-pass, 2: high-pass, 3: ladder), as read by the last `update()`.
      */
-    std::atomic<float>* p_resonance;
+    int getMode() const noexcept { return m_mode; };
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomFilter)
 
     /**
-     * The atomic parameter pointer for the filter's drive.
+     * Looks up the `g` coefficient of a cutoff, interpolating the shared coefficient table.
+     * @param frequency The cutoff frequency (Hz).
+     * @returns The `g` coefficient (`tan(pi * fc / fs)`).
      */
-    std::atomic<float>* p_drive;
+    float getCoefficient(float frequency) const noexcept;
 
     /**
-     * The atomic parameter pointer for the filter's type (low-pass, band-bass,
-     * or high-pass).
+     * The unique pointer for the waveshaper, useful in driving a filtered signal.
      */
-    std::atomic<float>* p_type;
+    std::unique_ptr<PhantomWaveshaper> m_waveshaper;
 
     /**
-     * The atomic parameter pointer for the filter's envelope
-     * generator's modulation depth.
+     * The parameter values for the current block.
      */
-    std::atomic<float>* p_egModDepth;
+    PhantomFilterParameters m_parameters;
 
     /**
-     * The atomic parameter pointer for the filter's LFO's
-     * modulation depth.
+     * The smoothed parameters (cutoff, resonance, drive and mod depths).
      */
-    std::atomic<float>* p_lfoModDepth;
+    const PhantomFilterRamps& m_ramps;
 
     /**
-     * The previous frequency value for preventing artifacting
-     * when changing and/or automating frequency cutoff.
+     * The sample rate, useful in computing the filter coefficients.
      */
-    float m_previousFrequency = 0.0f;
+    float m_sampleRate;
+
+    /** The base 2 logarithm of the sample rate, which normalizes the cutoff's octave. */
+    float m_log2SampleRate = 0.0f;
+
+    /** The upper bounds of the cutoff at the sample rate (below Nyquist). */
+    float m_cutoffUpperBounds = 0.0f;
+
+    /** The `g` coefficient of the last written sample. */
+    float m_coefficient = 0.0f;
+
+    /** The `g` coefficient at the next control point. */
+    float m_coefficientTarget = 0.0f;
+
+    /** The per-sample increment ramping `g` to the next control point. */
+    float m_coefficientIncrement = 0.0f;
+
+    /** Whether `g` holds a value yet (it jumps to the first control point after a reset). */
+    bool m_isCoefficientSet = false;
+
+    /** The number of samples between control points. */
+    int m_controlInterval = Consts::_MOD_CONTROL_INTERVAL;
+
+    /** The number of samples left until the next control point. */
+    int m_numUntilControl = 0;
 
     /**
-     * The number of channels to filter.
+     * The filter's mode for the current block.
      */
-    const int k_channelNumber = 0;
+    int m_mode = 0;
 
     /**
      * The cutoff modulation maximum amount, used as a multiplier.
@@ -108,12 +143,27 @@ private:
     /**
      * The lower bounds of the filter's cutoff.
      */
-    const float k_cutoffLowerBounds = 0.0f;
+    const float k_cutoffLowerBounds = 20.0f;
+
+    /**
+     * The upper bounds of the filter's cutoff (lowered to `k_maxNormalizedCutoff` at low sample rates).
+     */
+    const float k_cutoffUpperBounds = 20000.0f;
+
+    /**
+     * The highest cutoff as a fraction of the sample rate, which keeps `g` finite.
+     */
+    const float k_maxNormalizedCutoff = 0.45f;
+
+    /**
+     * The filter mode of the ladder.
+     */
+    const int k_ladderMode = 3;
 
     /**
-     * The upper bounds of the filter's cutoff.
+     * The ladder's feedback at the highest resonance, which is close to self-oscillation.
      */
-    const float k_cutoffUpperCounds = 11000.0f;
+    const float k_ladderMaxFeedback = 4.0f;
 };
 
 #endif
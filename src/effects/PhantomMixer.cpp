@@ -12,37 +12,41 @@
 
 #include "../utils/PhantomUtils.h"
 
-PhantomMixer::PhantomMixer(AudioProcessorValueTreeState& vts) : m_parameters(vts)
+PhantomMixer::PhantomMixer(const PhantomMixerRamps& ramps) : m_ramps(ramps)
 {
     m_rng.reset(new Random());
-
-    p_oscBalance = m_parameters.getRawParameterValue(Consts::_MIXER_OSC_BAL_PARAM_ID);
-    p_ampGain = m_parameters.getRawParameterValue(Consts::_MIXER_AMP_GAIN_PARAM_ID);
-    p_ringMod = m_parameters.getRawParameterValue(Consts::_MIXER_RING_MOD_PARAM_ID);
-    p_noise = m_parameters.getRawParameterValue(Consts::_MIXER_NOISE_PARAM_ID);
 }
 
 PhantomMixer::~PhantomMixer()
 {
     m_rng = nullptr;
-
-    p_oscBalance = nullptr;
-    p_ampGain = nullptr;
-    p_ringMod = nullptr;
-    p_noise = nullptr;
 }
 
-float PhantomMixer::evaluate(float osc01Val, float osc02Val) noexcept
+void PhantomMixer::evaluate(float* dest, const float* osc01Vals, const float* osc02Vals, int numSamples) noexcept
 {
-    float osc = osc01Val * (1.0f - *p_oscBalance) + osc02Val * *p_oscBalance;
+    const float* oscBalance = m_ramps.oscBalance.values;
+    const float* ringMod = m_ramps.ringMod.values;
+    const float* ampGain = m_ramps.ampGain.values;
+    const float gainScale = 1.0f / std::sqrt(3.0f);
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        float osc = osc01Vals[i] * (1.0f - oscBalance[i]) + osc02Vals[i] * oscBalance[i];
+        float ring = osc01Vals[i] * osc02Vals[i] * ringMod[i];
+
+        dest[i] = (osc + osc + ring) * ampGain[i] * gainScale;
+    }
 
-    float ringMod = osc01Val * osc02Val * *p_ringMod;
+    if(!m_ramps.noise.isSmoothing && m_ramps.noise.value == 0.0f)
+        return;
 
-    float random = (m_rng->nextFloat() + m_previousNoise) / 2.0f;
-    float noise = (random * 2.0f - 1.0f) * *p_noise;
-    m_previousNoise = random;
+    const float* noise = m_ramps.noise.values;
 
-    float mixed = (osc + osc + ringMod + noise) / std::sqrtf(3.0f);
+    for(int i = 0; i < numSamples; i++)
+    {
+        float random = (m_rng->nextFloat() + m_previousNoise) / 2.0f;
+        m_previousNoise = random;
 
-    return mixed * *p_ampGain;
+        dest[i] += (random * 2.0f - 1.0f) * noise[i] * ampGain[i] * gainScale;
+    }
 }
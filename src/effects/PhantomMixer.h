@@ -13,6 +13,8 @@
 
 #include "JuceHeader.h"
 
+#include "../utils/PhantomParameters.h"
+
 /**
  * Class for mixing things like oscillator outputs and also applying effects,
  * namely ring modulation and random noise.
@@ -20,17 +22,19 @@
 class PhantomMixer
 {
 public:
-    PhantomMixer(AudioProcessorValueTreeState&);
+    PhantomMixer(const PhantomMixerRamps&);
     ~PhantomMixer();
 
     /**
-     * Mixes two oscillator values along with optional parameters: ring modulation
+     * Mixes two blocks of oscillator values along with optional parameters: ring modulation
      * and noise.
-     * @param osc01Val The first oscillator sample value.
-     * @param osc02Val The second oscillator sample value.
+     * @param dest The array to write the mixed values to.
+     * @param osc01Vals The first oscillator sample values.
+     * @param osc02Vals The second oscillator sample values.
+     * @param numSamples The number of sample values to mix.
      * @noexcept
      */
-    float evaluate(float osc01Val, float osc02Val) noexcept;
+    void evaluate(float* dest, const float* osc01Vals, const float* osc02Vals, int numSamples) noexcept;
 
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomMixer)
@@ -40,31 +44,10 @@ private:
      */
     std::unique_ptr<Random> m_rng;
 
-    AudioProcessorValueTreeState& m_parameters;
-
-    /**
-     * The atomic parameter pointer for oscillator balance, which mixes the output between
-     * oscillator 1 and 2.
-     */
-    std::atomic<float>* p_oscBalance;
-
-    /**
-     * The atomic parameter pointer for amplifier gain, which effectively controls
-     * how much of the signal is output by the mixer (in terms of amplitude).
-     */
-    std::atomic<float>* p_ampGain;
-    
-    /**
-     * The atomic parameter pointer for ring modulation, which controls the level that ring
-     * modulation will be added to the output.
-     */
-    std::atomic<float>* p_ringMod;
-    
     /**
-     * The atomic parameter pointer for random noise, which controls the level that noise 
-     * will be added to the output.
+     * The smoothed parameters (oscillator balance, gain, ring modulation and noise).
      */
-    std::atomic<float>* p_noise;
+    const PhantomMixerRamps& m_ramps;
 
     /**
      * The previous value for the noise, to help discontinuities.
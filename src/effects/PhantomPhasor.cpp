@@ -12,79 +12,79 @@
 
 #include "../utils/PhantomUtils.h"
 
-PhantomPhasor::PhantomPhasor(AudioProcessorValueTreeState& vts, int phasorNumber) : m_parameters(vts), m_phasorNumber(phasorNumber)
+PhantomPhasor::PhantomPhasor(const PhantomPhasorRamps& ramps) : m_ramps(ramps)
 {
-    initParameters();
+
 }
 
 PhantomPhasor::~PhantomPhasor()
 {
-    p_shape = nullptr;
-    p_egInt = nullptr;
-    p_lfoInt = nullptr;
+
+}
+
+void PhantomPhasor::update(const PhantomPhasorParameters& parameters) noexcept
+{
+    m_parameters = parameters;
 }
 
-void PhantomPhasor::initParameters()
+void PhantomPhasor::evaluateAmounts(float* dest, const float* egMod, const float* lfoMod, int numSamples) noexcept
 {
-    switch(m_phasorNumber)
+    const float* egInt = m_ramps.egInt.values;
+    const float* lfoInt = m_ramps.lfoInt.values;
+
+    for(int i = 0; i < numSamples; i++)
     {
-        default:
-        case 1:
-            p_shape = m_parameters.getRawParameterValue(Consts::_PHASOR_01_SHAPE_PARAM_ID);
-            p_egInt = m_parameters.getRawParameterValue(Consts::_PHASOR_01_EG_INT_PARAM_ID);
-            p_lfoInt = m_parameters.getRawParameterValue(Consts::_PHASOR_01_LFO_INT_PARAM_ID);
-            break;
-
-        case 2:
-            p_shape = m_parameters.getRawParameterValue(Consts::_PHASOR_02_SHAPE_PARAM_ID);
-            p_egInt = m_parameters.getRawParameterValue(Consts::_PHASOR_02_EG_INT_PARAM_ID);
-            p_lfoInt = m_parameters.getRawParameterValue(Consts::_PHASOR_02_LFO_INT_PARAM_ID);
-            break;
+        float egScale = egInt[i] * (lfoInt[i] * -0.5f + 1.0f);
+        float lfoScale = lfoInt[i] * (egInt[i] * -0.5f + 1.0f);
+
+        dest[i] = egScale * egMod[i] + lfoScale * (lfoMod[i] * 0.5f + 0.5f);
     }
 }
 
-float PhantomPhasor::apply(float phase, float egMod, float lfoMod) noexcept
+int PhantomPhasor::getShape() const noexcept
 {
-    float envelope = *p_egInt * egMod * (*p_lfoInt * -0.5f + 1.0f);
-    float lfo = *p_lfoInt * (lfoMod * 0.5f + 0.5f) * (*p_egInt * -0.5f + 1.0f);
-    float mod = envelope + lfo;
+    return (int) m_parameters.shape;
+}
 
-    phase /= (float) Consts::_WAVETABLE_SIZE;
+int PhantomPhasor::getNumShapes() noexcept
+{
+    return getWarpCurves().size();
+}
 
-    float phasor = evaluate(phase);
-    phase = (phasor * mod) + (phase * (1.0f - mod));
+const PhantomPhasor::WarpCurve& PhantomPhasor::getWarpCurve(int shape) noexcept
+{
+    const Array<WarpCurve>& curves = getWarpCurves();
 
-    return phase * (float) Consts::_WAVETABLE_SIZE;
+    return curves.getReference(isPositiveAndBelow(shape, curves.size()) ? shape : 0);
 }
 
-float PhantomPhasor::evaluate(float phase) noexcept
+const Array<PhantomPhasor::WarpCurve>& PhantomPhasor::getWarpCurves() noexcept
 {
-    switch((int) *p_shape)
+    /** NOTE: New (or user-defined) shapes are added here, the wavetable store builds their tables. */
+    static const Array<WarpCurve> curves
     {
-        default:
-        case 0:
-            return sawtooth(phase);
-            break;
-
-        case 1:
-            return 1.0f - sawtooth(phase);
-            break;
-    }
+        /** Sawtooth: the first half of the cycle is swept through in the first 1% of the phase. */
+        WarpCurve { Breakpoint { 0.0f, 0.0f }, Breakpoint { 0.01f, 0.5f }, Breakpoint { 1.0f, 1.0f } },
+
+        /** Inverted sawtooth. */
+        WarpCurve { Breakpoint { 0.0f, 1.0f }, Breakpoint { 0.01f, 0.5f }, Breakpoint { 1.0f, 0.0f } }
+    };
+
+    return curves;
 }
 
-float PhantomPhasor::sawtooth(float phase) noexcept
+float PhantomPhasor::evaluate(float phase, const WarpCurve& curve) noexcept
 {
-    float slope;
+    const Breakpoint* breakpoints = curve.begin();
+    const int last = curve.size() - 1;
 
-    float breakpoint = 0.01f;
-    if(phase <= breakpoint)
-    {
-        slope = 0.5f / breakpoint;
-        return slope * phase;
-    }
-    else
-    {
-        slope = 0.5f / (1.0f - breakpoint);
-        return slope * (phase - breakpoint) + 0.5f;
-    }
+    int segment = 0;
+    while(segment < last - 1 && phase > breakpoints[segment + 1].phase)
+        segment++;
+
+    const Breakpoint& start = breakpoints[segment];
+    const Breakpoint& end = breakpoints[segment + 1];
+
+    const float slope = (end.value - start.value) / (end.phase - start.phase);
+    return start.value + slope * (phase - start.phase);
 }
@@ -13,6 +13,8 @@
 
 #include "JuceHeader.h"
 
+#include "../utils/PhantomParameters.h"
+
 /**
  * The audio component for applying the phase distortion (intended for a 
  * `PhantomOscillator`) effect.
@@ -20,63 +22,85 @@
 class PhantomPhasor
 {
 public:
-    PhantomPhasor(AudioProcessorValueTreeState&, int);
+    PhantomPhasor(const PhantomPhasorRamps&);
     ~PhantomPhasor();
 
     /**
-     * Applies the phase distortion effect to a given phase.
-     * @param phase The phase value to apply the effect to.
-     * @param egMod The envelope generator modulation value.
-     * @param lfoMod The LFO modulation value.
-     * @returns The phase-distorted value with modulation applied.
+     * Updates the phasor's parameters (shape), the modulation intensities are smoothed.
+     * @param parameters The phasor's parameter values for the block.
      */
-    float apply(float phase, float egMod, float lfoMod) noexcept;
+    void update(const PhantomPhasorParameters& parameters) noexcept;
 
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomPhasor)
+    /**
+     * Computes the amount of phase distortion (with modulation applied) for a block, which the
+     * oscillator's band-limited wavetables are read with.
+     * @param dest The array to write the distortion amounts (in the range [0, 1]) to.
+     * @param egMod The envelope generator modulation values.
+     * @param lfoMod The LFO modulation values.
+     * @param numSamples The number of amounts to compute.
+     */
+    void evaluateAmounts(float* dest, const float* egMod, const float* lfoMod, int numSamples) noexcept;
 
     /**
-     * Initializes `AudioProcessorValueTreeState` parameters for the phasor.
+     * @returns The phasor shape for the current block.
      */
-    void initParameters();
+    int getShape() const noexcept;
 
     /**
-     * Computes the phase distortion effect for a given phase value.
-     * @param phase The phase value to apply the effect to.
-     * @returns The phase-distorted value.
+     * A breakpoint of a warp curve.
+     * @property phase The normalized phase ([0, 1]) of the breakpoint.
+     * @property value The distorted phase at the breakpoint.
      */
-    float evaluate(float phase) noexcept;
+    struct Breakpoint
+    {
+        float phase;
+        float value;
+    };
 
     /**
-     * Computes the phase distortion values for a sawtooth-like sound.
-     * @param phase The phase value to use.
-     * @returns The phase-distorted value for a sawtooth.
+     * A phase warp curve, as the breakpoints of a piecewise-linear map from the normalized phase
+     * to the distorted phase. The breakpoints are sorted by phase, from 0 to 1.
+     * NOTE: Curves are only evaluated when the wavetables are built (the tables bake in the warp),
+     * so a shape adds no cost per sample however many segments its curve has.
      */
-    float sawtooth(float phase) noexcept;
+    using WarpCurve = Array<Breakpoint>;
 
-    AudioProcessorValueTreeState& m_parameters;
+    /**
+     * @returns The number of phasor shapes (which the wavetable store builds tables for).
+     */
+    static int getNumShapes() noexcept;
 
     /**
-     * The atomic parameter pointer for the phasor's shape.
+     * @param shape The phasor shape (out of range values return the first shape).
+     * @returns The warp curve of the phasor shape.
      */
-    std::atomic<float>* p_shape;
+    static const WarpCurve& getWarpCurve(int shape) noexcept;
+
+    /**
+     * Computes the phase distortion effect for a given phase value.
+     * @param phase The normalized phase value ([0, 1]) to apply the effect to.
+     * @param curve The warp curve to distort the phase with.
+     * @returns The phase-distorted value.
+     */
+    static float evaluate(float phase, const WarpCurve& curve) noexcept;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomPhasor)
 
     /**
-     * The atomic parameter pointer for the phasor's envelope
-     * generator intensity.
+     * @returns The warp curves of every phasor shape, indexed by the shape.
      */
-    std::atomic<float>* p_egInt;
+    static const Array<WarpCurve>& getWarpCurves() noexcept;
 
     /**
-     * The atomic parameter pointer for the phasor's LFO intensity.
+     * The parameter values for the current block.
      */
-    std::atomic<float>* p_lfoInt;
+    PhantomPhasorParameters m_parameters;
 
     /**
-     * The phasor identifier, useful in assigning the correct 
-     * `AudioProcessorValueTreeState` parameters.
+     * The smoothed parameters (modulation intensities).
      */
-    int m_phasorNumber;
+    const PhantomPhasorRamps& m_ramps;
 };
 
 #endif
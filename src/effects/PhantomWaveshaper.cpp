@@ -10,6 +10,8 @@
 
 #include "PhantomWaveshaper.h"
 
+#include "../utils/PhantomMath.h"
+
 PhantomWaveshaper::PhantomWaveshaper()
 {
 
@@ -22,17 +24,19 @@ PhantomWaveshaper::~PhantomWaveshaper()
 
 float PhantomWaveshaper::fexp2(float x) noexcept
 {
-    float s = sign(-x);
-    float t1 = 1.0f - std::expf(std::abs(x));
+    float t1 = PhantomMath::exp(std::abs(x)) - 1.0f;
     float t2 = MathConstants<float>::euler - 1.0f;
 
-    return s * t1 / t2;
+    return std::copysign(t1 / t2, x);
 }
 
 float PhantomWaveshaper::atsr(float x) noexcept
 {
-    float t1 = 2.5f * std::atanf(0.9f * x);
-    float t2 = 2.5f * std::sqrtf(1.0f - std::powf(0.9f * x, 2.0f));
+    /** NOTE: The square root is undefined past |0.9x| = 1, so the argument is clipped there. */
+    float y = clip(0.9f * x, -1.0f, 1.0f);
+
+    float t1 = 2.5f * PhantomMath::atan(y);
+    float t2 = 2.5f * std::sqrt((1.0f - y) * (1.0f + y));
 
     return t1 + t2 - 2.5f;
 }
@@ -44,10 +48,108 @@ float PhantomWaveshaper::cube(float x) noexcept
 
 float PhantomWaveshaper::htan(float k, float x) noexcept
 {
-    return std::tanhf((k * 17.0f + 1.0f) * x);
+    return PhantomMath::tanh((k * 17.0f + 1.0f) * x);
 }
 
 float PhantomWaveshaper::hclip(float x) noexcept
 {
-    return std::abs(x) > 0.5f ? 0.5f * sign(x) : x;
+    return clip(x, -0.5f, 0.5f);
+}
+
+void PhantomWaveshaper::fexp2(float* samples, const float* mix, int numSamples) noexcept
+{
+    for(int i = 0; i < numSamples; i++)
+        samples[i] += mix[i] * (fexp2(samples[i]) - samples[i]);
+}
+
+void PhantomWaveshaper::atsr(float* samples, const float* mix, int numSamples) noexcept
+{
+    for(int i = 0; i < numSamples; i++)
+        samples[i] += mix[i] * (atsr(samples[i]) - samples[i]);
+}
+
+void PhantomWaveshaper::cube(float* samples, const float* mix, int numSamples) noexcept
+{
+    for(int i = 0; i < numSamples; i++)
+        samples[i] += mix[i] * (cube(samples[i]) - samples[i]);
+}
+
+void PhantomWaveshaper::htan(float* samples, const float* drive, int numSamples) noexcept
+{
+    for(int i = 0; i < numSamples; i++)
+        samples[i] += drive[i] * (htan(drive[i], samples[i]) - samples[i]);
+}
+
+void PhantomWaveshaper::hclip(float* samples, const float* mix, int numSamples) noexcept
+{
+    for(int i = 0; i < numSamples; i++)
+        samples[i] += mix[i] * (hclip(samples[i]) - samples[i]);
+}
+
+void PhantomWaveshaper::atsrADAA(float* samples, const float* mix, int numSamples) noexcept
+{
+    float x0 = m_previousInput;
+    float F0 = atsrAntiderivative(x0);
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        const float x1 = samples[i];
+        const float F1 = atsrAntiderivative(x1);
+        const float dx = x1 - x0;
+
+        const float shape = std::abs(dx) < k_adaaTolerance ? atsr(0.5f * (x0 + x1)) : (F1 - F0) / dx - 2.5f;
+        samples[i] += mix[i] * (shape - x1);
+
+        x0 = x1;
+        F0 = F1;
+    }
+
+    m_previousInput = x0;
+}
+
+void PhantomWaveshaper::htanADAA(float* samples, const float* drive, int numSamples) noexcept
+{
+    float x0 = m_previousInput;
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        /** NOTE: Both ends are integrated with the current drive, which keeps drive sweeps from clicking. */
+        const float x1 = samples[i];
+        const float dx = x1 - x0;
+
+        const float shape = std::abs(dx) < k_adaaTolerance
+            ? htan(drive[i], 0.5f * (x0 + x1))
+            : (htanAntiderivative(drive[i], x1) - htanAntiderivative(drive[i], x0)) / dx;
+
+        samples[i] += drive[i] * (shape - x1);
+
+        x0 = x1;
+    }
+
+    m_previousInput = x0;
+}
+
+void PhantomWaveshaper::reset(float previousInput) noexcept
+{
+    m_previousInput = previousInput;
+}
+
+float PhantomWaveshaper::atsrAntiderivative(float x) noexcept
+{
+    float y = clip(0.9f * x, -1.0f, 1.0f);
+    float root = std::sqrt((1.0f - y) * (1.0f + y));
+
+    /** NOTE: `asin(y)` is written with `atan()`, whose argument stays in [-1, 1]. */
+    float t1 = y * PhantomMath::atan(y) - 0.5f * PhantomMath::log(1.0f + y * y);
+    float t2 = 0.5f * (y * root + 2.0f * PhantomMath::atan(y / (1.0f + root)));
+
+    return (2.5f / 0.9f) * (t1 + t2) + (atsr(x) + 2.5f) * (x - y / 0.9f);
+}
+
+float PhantomWaveshaper::htanAntiderivative(float k, float x) noexcept
+{
+    float a = k * 17.0f + 1.0f;
+    float u = std::abs(x);
+
+    return u + (PhantomMath::log(1.0f + PhantomMath::exp(-2.0f * a * u)) - 0.693147181f) / a;
 }
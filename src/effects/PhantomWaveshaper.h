@@ -26,6 +26,11 @@ public:
      * NOTE: The following waveshaper functions are (roughly)
      * listed in order of increasing intensity. Each functions returns a 
      * waveshaped value in between the range [-1.0f, 1.0f]. 
+     *
+     * The transcendental functions are approximated by `PhantomMath`, which keeps
+     * every shaper within 3e-6 of its standard library version, except `atsr()` next to
+     * the point where it clips (|0.9x| = 1), where the square root magnifies the rounding
+     * of its argument to about 1e-5 (see `tests/PhantomWaveshaperTests.cpp`).
      */
 
     /**
@@ -53,6 +58,69 @@ public:
      */
     float hclip(float x) noexcept;
 
+    /**
+     * NOTE: The following block functions shape the samples in place and blend them
+     * with the dry samples by a mix value. Their loops have no branches or calls, so
+     * they vectorize.
+     * @param samples The samples to shape.
+     * @param mix The mix values in the range [0, 1], where 0 leaves a sample dry.
+     * @param numSamples The number of samples.
+     */
+
+    /**
+     * Fuzz Exponential 2 (block)
+     */
+    void fexp2(float* samples, const float* mix, int numSamples) noexcept;
+
+    /**
+     * Arctangent Square Root (block)
+     */
+    void atsr(float* samples, const float* mix, int numSamples) noexcept;
+
+    /**
+     * Cube (block)
+     */
+    void cube(float* samples, const float* mix, int numSamples) noexcept;
+
+    /**
+     * Hyberbolic Tangent (block), which uses the mix values as the drive `k` as well.
+     */
+    void htan(float* samples, const float* drive, int numSamples) noexcept;
+
+    /**
+     * Hard Clip (block)
+     */
+    void hclip(float* samples, const float* mix, int numSamples) noexcept;
+
+    /**
+     * NOTE: The following block functions are the first-order antiderivative anti-aliased
+     * (ADAA) versions of their shapers. Each sample is the average of the shaper over the
+     * segment from the previous input to the current one, `(F(x1) - F(x0)) / (x1 - x0)` with
+     * `F` the shaper's closed-form antiderivative, which suppresses the aliasing of high drive
+     * settings without oversampling (at the cost of a half sample delay of the shaped signal).
+     * The previous input is kept between blocks, so an instance must shape a single signal.
+     * @param samples The samples to shape.
+     * @param mix The mix values in the range [0, 1], where 0 leaves a sample dry.
+     * @param numSamples The number of samples.
+     */
+
+    /**
+     * Arctangent Square Root (anti-aliased block)
+     */
+    void atsrADAA(float* samples, const float* mix, int numSamples) noexcept;
+
+    /**
+     * Hyberbolic Tangent (anti-aliased block), which uses the mix values as the drive `k` as well.
+     */
+    void htanADAA(float* samples, const float* drive, int numSamples) noexcept;
+
+    /**
+     * Resets the state of the anti-aliased shapers.
+     * @param previousInput The input the next block continues from, which is the last
+     * sample of a block that skipped the shaper (or silence on a new note).
+     */
+    void reset(float previousInput = 0.0f) noexcept;
+
     /**
      * Clips a value between a lower and upper bound.
      * @param x The value to clip.
@@ -72,6 +140,32 @@ public:
 
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomWaveshaper)
+
+    /**
+     * The antiderivative of `atsr()` (without its constant offset, which is added back after
+     * the averaging), continued linearly where `atsr()` clips its argument.
+     */
+    float atsrAntiderivative(float x) noexcept;
+
+    /**
+     * The antiderivative of `htan()`: `ln(cosh(a * x)) / a` with `a = k * 17 + 1`, written as
+     * `|x| + (ln(1 + e^(-2a|x|)) - ln(2)) / a` so it never overflows.
+     */
+    float htanAntiderivative(float k, float x) noexcept;
+
+    /** The last input of the previous block. */
+    float m_previousInput = 0.0f;
+
+    /**
+     * The input difference below which the averaging is ill-conditioned, where the shaper is
+     * evaluated at the midpoint of the segment instead.
+     * NOTE: The averaging divides the rounding of the (float) antiderivatives, about 1e-6, by
+     * the difference, while the midpoint misses the curvature of the segment (which is steep
+     * next to the clipping of `atsr()`). Measured over inputs in [-2, 2] and drives in [0, 1],
+     * the worst error is 6.6e-3 for 1e-4, 2.1e-3 for 3e-4, 0.8e-3 to 1.2e-3 for 1e-3 and 9.9e-3
+     * for 2e-3, so 1e-3 keeps both sources near -60 dB.
+     */
+    const float k_adaaTolerance = 1e-3f;
 };
 
 #endif
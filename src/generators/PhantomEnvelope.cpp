@@ -10,95 +10,67 @@
 
 #include "PhantomEnvelope.h"
 
-PhantomEnvelope::PhantomEnvelope(AudioProcessorValueTreeState& vts, EnvelopeType type) : m_parameters(vts), m_type(type)
+PhantomEnvelope::PhantomEnvelope(const PhantomRamp& sustain) : m_sustain(sustain)
 {
-    setEnvelopeType();
+    m_interpolator.reset(new PhantomInterpolator());
+
     setEnvelopeParameters();
 }
 
 PhantomEnvelope::~PhantomEnvelope()
 {
-    p_attack = nullptr;
-    p_decay = nullptr;
-    p_sustain = nullptr;
-    p_release = nullptr;
+    m_interpolator = nullptr;
 }
 
-void PhantomEnvelope::update(float sampleRate) noexcept
+void PhantomEnvelope::update(const PhantomEnvelopeParameters& parameters, float sampleRate) noexcept
 {
+    m_parameters = parameters;
+
     setEnvelopeParameters();
-    setSampleRate(sampleRate);
+
+    /** NOTE: At control rate, every call to `getNextSample()` advances the envelope by a whole interval. */
+    setSampleRate(sampleRate / (float) m_interpolator->getInterval());
+}
+
+void PhantomEnvelope::setControlInterval(int interval) noexcept
+{
+    m_interpolator->setInterval(interval);
 }
 
-float PhantomEnvelope::evaluate() noexcept
+void PhantomEnvelope::reset() noexcept
 {
-    float result = (getNextSample() + m_previousSample) / 2.0f;
-    m_previousSample = result;
-    
-    return result;
+    ADSR::reset();
+
+    m_previousSample = 0.0f;
+    m_interpolator->reset(0.0f);
 }
 
-void PhantomEnvelope::setEnvelopeType()
+void PhantomEnvelope::evaluate(float* dest, int numSamples) noexcept
 {
-    jassert((int) m_type != -1);
+    if(m_interpolator->getInterval() > 1)
+    {
+        m_interpolator->process(dest, numSamples, [this] { return getNextSample(); });
+        return;
+    }
 
-    char* atkParamId;
-    char* decParamId;
-    char* susParamId;
-    char* relParamId;
+    float previousSample = m_previousSample;
 
-    switch(m_type)
+    for(int i = 0; i < numSamples; i++)
     {
-        default:
-        case EnvelopeType::AMP:
-            atkParamId = Consts::_AMP_EG_ATK_PARAM_ID;
-            decParamId = Consts::_AMP_EG_DEC_PARAM_ID;
-            susParamId = Consts::_AMP_EG_SUS_PARAM_ID;
-            relParamId = Consts::_AMP_EG_REL_PARAM_ID;
-            break;
-
-        case EnvelopeType::PHASOR:
-            atkParamId = Consts::_PHASOR_EG_ATK_PARAM_ID;
-            decParamId = Consts::_PHASOR_EG_DEC_PARAM_ID;
-            susParamId = Consts::_PHASOR_EG_SUS_PARAM_ID;
-            relParamId = Consts::_PHASOR_EG_REL_PARAM_ID;
-            break;
-
-        case EnvelopeType::FILTER:
-            atkParamId = Consts::_FLTR_EG_ATK_PARAM_ID;
-            decParamId = Consts::_FLTR_EG_DEC_PARAM_ID;
-            susParamId = Consts::_FLTR_EG_SUS_PARAM_ID;
-            relParamId = Consts::_FLTR_EG_REL_PARAM_ID;
-            break;
-
-        case EnvelopeType::MOD:
-            atkParamId = Consts::_MOD_EG_ATK_PARAM_ID;
-            decParamId = Consts::_MOD_EG_DEC_PARAM_ID;
-            susParamId = Consts::_MOD_EG_SUS_PARAM_ID;
-            relParamId = Consts::_MOD_EG_REL_PARAM_ID;
-            break;
+        previousSample = (getNextSample() + previousSample) * 0.5f;
+        dest[i] = previousSample;
     }
 
-    p_attack = m_parameters.getRawParameterValue(atkParamId);
-    p_decay = m_parameters.getRawParameterValue(decParamId);
-    p_sustain = m_parameters.getRawParameterValue(susParamId);
-    p_release = m_parameters.getRawParameterValue(relParamId);
+    m_previousSample = previousSample;
 }
 
 void PhantomEnvelope::setEnvelopeParameters() noexcept
 {
-    m_envelope.attack = *p_attack;
-    m_envelope.decay = *p_decay;
-    m_envelope.release = *p_release;
+    m_envelope.attack = m_parameters.attack;
+    m_envelope.decay = m_parameters.decay;
+    m_envelope.release = m_parameters.release;
 
-    if(m_previousSustain != *p_sustain)
-    {
-        float sustain = (m_previousSustain + *p_sustain) / 2.0f;
-        m_previousSustain = sustain;
-
-        float gain = powf(2.0f, sustain / 6.0f);
-        m_envelope.sustain = gain; 
-    }
+    m_envelope.sustain = powf(2.0f, m_sustain.value / 6.0f);
 
     setParameters(m_envelope);
 }
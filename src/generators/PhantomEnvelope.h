@@ -14,6 +14,8 @@
 #include "JuceHeader.h"
 
 #include "../utils/PhantomData.h"
+#include "../utils/PhantomInterpolator.h"
+#include "../utils/PhantomParameters.h"
 #include "../utils/PhantomUtils.h"
 
 /**
@@ -23,68 +25,61 @@
 class PhantomEnvelope : public ADSR
 {
 public:
-    PhantomEnvelope(AudioProcessorValueTreeState& vts, EnvelopeType type);
+    PhantomEnvelope(const PhantomRamp&);
     ~PhantomEnvelope();
 
     /**
-     * Updates the envelope's parameters (ADSR).
+     * Updates the envelope's parameters (ADSR), with the sustain level read from its smoothed ramp.
+     * @param parameters The envelope's parameter values for the block.
      * @param sampleRate The sample rate to use in calculating the envelope.
      */
-    void update(float sampleRate) noexcept;
+    void update(const PhantomEnvelopeParameters& parameters, float sampleRate) noexcept;
 
     /**
-     * Computes the next value for the envelope.
-     * @returns The next generated envelope value.
+     * Sets the rate the envelope is computed at, which takes effect on the next `update()`.
+     * @param interval The number of samples between computed values, which are linearly 
+     * interpolated (1 computes every sample).
      */
-    float evaluate() noexcept;
+    void setControlInterval(int interval) noexcept;
 
-    /** The atomic parameter value for the EG' sustain. */
-    std::atomic<float>* p_sustain;
-
-private:
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomEnvelope)
+    /**
+     * Resets the envelope to idle and clears the interpolation.
+     */
+    void reset() noexcept;
 
     /**
-     * Sets the envelope type, relevant for binding to
-     * the appropriate `AudioProcessValueTreeState` parameter.
+     * Computes the next block of values for the envelope.
+     * @param dest The array to write the generated envelope values to.
+     * @param numSamples The number of values to generate.
      */
-    void setEnvelopeType();
+    void evaluate(float* dest, int numSamples) noexcept;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomEnvelope)
 
     /**
-     * Updates the ADSR parameters with the atomic parameter
-     * values.
+     * Updates the ADSR parameters with the parameter
+     * values of the block.
      */
     void setEnvelopeParameters() noexcept;
 
     /** The envelope ADSR parameters struct. */
     ADSR::Parameters m_envelope;
 
-    /** The envelope generator type (enum value). */
-    EnvelopeType m_type = (EnvelopeType) -1;
-
-    AudioProcessorValueTreeState& m_parameters;
-
-    /** The atomic parameter value for the EG' attack. */
-    std::atomic<float>* p_attack;
-
-    /** The atomic parameter value for the EG' decay. */
-    std::atomic<float>* p_decay;
-
-    // /** The atomic parameter value for the EG' sustain. */
-    // std::atomic<float>* p_sustain;
-
-    /** The atomic parameter value for the EG' release. */
-    std::atomic<float>* p_release;
+    /** The parameter values for the current block. */
+    PhantomEnvelopeParameters m_parameters;
 
     /**
-     * The previous sustain value for preventing artifacting
-     * on fast sustain changes and/or automation.
+     * The smoothed sustain level, which is read once per block.
      * CAUTION: This value is in units of decibels (dB).
      */
-    float m_previousSustain;
+    const PhantomRamp& m_sustain;
 
     /** The previous envelope value to avoid discontinuities. */
     float m_previousSample = 0.0f;
+
+    /** The unique pointer to the interpolator running the envelope at control rate. */
+    std::unique_ptr<PhantomInterpolator> m_interpolator;
 };
 
 #endif
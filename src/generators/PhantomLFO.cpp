@@ -12,103 +12,135 @@
 
 #include "../utils/PhantomUtils.h"
 
-PhantomLFO::PhantomLFO(AudioProcessorValueTreeState& vts, int lfoNumber) : m_parameters(vts), m_lfoNumber(lfoNumber)
+PhantomLFO::PhantomLFO()
 {
-    initParameters();
-    resetWavetable();
+    m_rng.reset(new Random());
+    m_interpolator.reset(new PhantomInterpolator());
+
+    m_wavetable = m_wavetables->getLFOTable((int) m_parameters.shape);
 }
 
 PhantomLFO::~PhantomLFO()
 {
-    p_rate = nullptr;
-    p_shape = nullptr;
+    m_rng = nullptr;
+    m_interpolator = nullptr;
 }
 
-void PhantomLFO::hiResTimerCallback()
+void PhantomLFO::update(const PhantomLFOParameters& parameters, float sampleRate) noexcept
 {
-    
+    m_parameters = parameters;
+
+    m_sampleRate = sampleRate;
+    updatePhaseDelta();
+
+    m_fadeDecrement = 1.0f / (Consts::_PARAM_SMOOTHING_TIME * m_sampleRate);
+
+    if(!m_isShapeSet || (int) m_parameters.shape != m_shape)
+        setShape((int) m_parameters.shape);
 }
 
-void PhantomLFO::initParameters()
+void PhantomLFO::setShape(int shape) noexcept
 {
-    switch(m_lfoNumber)
-    {
-        default:
-        case 1:
-            p_rate = m_parameters.getRawParameterValue(Consts::_LFO_01_RATE_PARAM_ID);
-            p_shape = m_parameters.getRawParameterValue(Consts::_LFO_01_SHAPE_PARAM_ID);
-            break;
-        
-        case 2:
-            p_rate = m_parameters.getRawParameterValue(Consts::_LFO_02_RATE_PARAM_ID);
-            p_shape = m_parameters.getRawParameterValue(Consts::_LFO_02_SHAPE_PARAM_ID);
-            break;
-    }
-    
-    m_previousShape = *p_shape;
+    const bool isFading = m_isShapeSet;
+
+    m_wavetable = m_wavetables->getLFOTable(shape);
+    m_shape = shape;
+    m_isShapeSet = true;
+
+    if(!isFading)
+        return;
+
+    /**
+     * NOTE: The fade starts from the value being output rather than from the previous shape, 
+     * so a change in the middle of a fade (or to and from the held noise value) doesn't jump.
+     */
+    const float value = m_shape == k_noiseShape ? m_sampleValue : readWavetable(m_wavetable, m_phase);
+
+    m_fadeOffset = m_outputValue - value;
+    m_fade = 1.0f;
 }
 
-void PhantomLFO::resetWavetable() noexcept
+void PhantomLFO::setControlInterval(int interval) noexcept
 {
-    m_wavetable.clearQuick();
+    m_interpolator->setInterval(interval);
+}
 
-    for (int i = 0; i < Consts::_WAVETABLE_SIZE; i++)
-    {
-        float position = (float) i / Consts::_WAVETABLE_SIZE;
+void PhantomLFO::evaluate(float* dest, int numSamples) noexcept
+{
+    if(numSamples <= 0) return;
 
-        float value;
-        switch((int) *p_shape)
+    /** NOTE: The shape and the cross-fade are fixed for the block, so the loops test them without a misprediction. */
+    const bool isNoise = m_shape == k_noiseShape;
+    const bool isFading = m_fade > 0.0f;
+
+    if(m_interpolator->getInterval() > 1)
+    {
+        m_interpolator->process(dest, numSamples, [this, isNoise, isFading] { return nextControlValue(isNoise, isFading); });
+    }
+    else if(!isNoise)
+    {
+        for(int i = 0; i < numSamples; i++)
         {
-            default:
-            case 0:
-            case 4:
-                value = sinf(MathConstants<float>::twoPi * position);
-                break;
-
-            case 1:
-                value = 2.0f * abs(position * 2.0f - 1.0f) - 1.0f;
-                break;
-
-            case 2:
-                value = position * 2.0f - 1.0f;
-                break;
-
-            case 3:
-                value = position <= 0.5f ? 1.0f : -1.0f;
-                break;
+            m_sampleValue = readWavetable(m_wavetable, m_phase);
+            dest[i] = isFading ? fadeValue(m_sampleValue, 1) : m_sampleValue;
+            m_phase += m_phaseDelta;
         }
+    }
+    else
+    {
+        /** NOTE: A new noise value is drawn every time the phase wraps. */
+        for(int i = 0; i < numSamples; i++)
+        {
+            const uint32 phase = m_phase + m_phaseDelta;
+
+            if(phase < m_phase)
+                m_sampleValue = m_rng->nextFloat() * 2.0f - 1.0f;
 
-        m_wavetable.insert(i, value);
+            dest[i] = isFading ? fadeValue(m_sampleValue, 1) : m_sampleValue;
+            m_phase = phase;
+        }
     }
+
+    m_outputValue = dest[numSamples - 1];
 }
 
-void PhantomLFO::update(float sampleRate) noexcept
+float PhantomLFO::nextControlValue(bool isNoise, bool isFading) noexcept
 {
-    m_sampleRate = sampleRate;
-    updatePhaseDelta();
+    const int interval = m_interpolator->getInterval();
+    const uint32 phase = m_phase + m_phaseDelta * (uint32) interval;
 
-    if(*p_shape != m_previousShape)
-    {
-        resetWavetable();
-        m_previousShape = *p_shape;
-    }
+    if(!isNoise)
+        m_sampleValue = readWavetable(m_wavetable, m_phase);
+    else if(phase < m_phase)
+        m_sampleValue = m_rng->nextFloat() * 2.0f - 1.0f;
+
+    m_phase = phase;
+
+    return isFading ? fadeValue(m_sampleValue, interval) : m_sampleValue;
 }
 
-float PhantomLFO::evaluate() noexcept
+float PhantomLFO::fadeValue(float value, int numSamples) noexcept
 {
-    if((int) *p_shape != 4)
-        m_sampleValue = m_wavetable[(int) m_phase];
-    else
-        if((int) m_phase <= 1)
-            m_sampleValue = Random::getSystemRandom().nextFloat() * 2.0f - 1.0f;
+    const float fade = m_fade;
+    m_fade = jmax(0.0f, m_fade - m_fadeDecrement * (float) numSamples);
+
+    return value + fade * m_fadeOffset;
+}
+
+float PhantomLFO::readWavetable(const float* wavetable, uint32 phase) const noexcept
+{
+    constexpr int fractionBits = 32 - Consts::_WAVETABLE_BITS;
+    constexpr uint32 fractionMask = (1u << fractionBits) - 1;
 
-    m_phase = fmod(m_phase + m_phaseDelta, Consts::_WAVETABLE_SIZE);
+    const int index = (int) (phase >> fractionBits);
+    const int nextIndex = (index + 1) & (Consts::_WAVETABLE_SIZE - 1);
+    const float fraction = (float) (phase & fractionMask) * (1.0f / (float) (1u << fractionBits));
 
-    return m_sampleValue;
+    return wavetable[index] + fraction * (wavetable[nextIndex] - wavetable[index]);
 }
 
 void PhantomLFO::updatePhaseDelta() noexcept
 {
-    float cyclesPerSample = *p_rate / m_sampleRate;
-    m_phaseDelta = cyclesPerSample * (float) Consts::_WAVETABLE_SIZE;
+    float cyclesPerSample = m_parameters.rate / m_sampleRate;
+    m_phaseDelta = phaseToFixed(cyclesPerSample * (float) Consts::_WAVETABLE_SIZE);
 }
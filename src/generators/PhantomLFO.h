@@ -13,98 +13,159 @@
 
 #include "JuceHeader.h"
 
+#include "PhantomWavetableStore.h"
+#include "../utils/PhantomInterpolator.h"
+#include "../utils/PhantomParameters.h"
+
 /**
  * The audio component for applying low-frequency modulations to
  * other areas in the synthesizer, namely filters, oscillators, phasors, 
  * etc.
  */
-class PhantomLFO : public HighResolutionTimer
+class PhantomLFO
 {
 public:
-    PhantomLFO(AudioProcessorValueTreeState&, int);
+    PhantomLFO();
     ~PhantomLFO();
 
     /**
-     * Called when the high-resolution timer hits zero.
+     * Enumerator with the modes of the LFO.
+     * @property VOICE Every voice runs its own LFO.
+     * @property GLOBAL The synth runs a single (free-running) LFO, which every voice reads.
      */
-    void hiResTimerCallback() override;
+    enum Mode
+    {
+        VOICE = 0,
+        GLOBAL
+    };
 
     /**
-     * Updates the LFO's parameters, namely rate and shape.
+     * Updates the LFO's parameters, namely rate and shape. A change of shape only swaps the
+     * (prebuilt) table that is read, and the output is faded from what was playing to the new shape.
+     * @param parameters The LFO's parameter values for the block.
      * @param sampleRate The sample rate needed for calculating the phase delta, determining read speed.
      */
-    void update(float sampleRate) noexcept;
+    void update(const PhantomLFOParameters& parameters, float sampleRate) noexcept;
+
+    /**
+     * Sets the rate the LFO is computed at.
+     * @param interval The number of samples between computed values, which are linearly 
+     * interpolated (1 computes every sample).
+     */
+    void setControlInterval(int interval) noexcept;
 
     /**
-     * Computes the next value for the LFO. 
+     * Computes the next block of values for the LFO. 
      * CAUTION: The output of this function is in biopolar format, meaning that 
      * it is in the range [-1.0f, 1.0f).
-     * @returns The next value read from the LFO.
+     * @param dest The array to write the LFO values to.
+     * @param numSamples The number of values to read from the LFO.
      */
-    float evaluate() noexcept;
+    void evaluate(float* dest, int numSamples) noexcept;
 
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomLFO)
 
     /**
-     * Initializes the parameters for the LFO.
+     * Updates the phase delta, which determines the read speed (affecting
+     * the rate).
+     */
+    void updatePhaseDelta() noexcept;
+
+    /**
+     * Swaps the table read by the LFO for the table of a shape, starting a cross-fade from the
+     * value being output.
+     * @param shape The LFO shape parameter value.
      */
-    void initParameters();
+    void setShape(int shape) noexcept;
 
     /**
-     * Resets the wavetable according the current shape parameter.
+     * Reads a wavetable at a fixed-point phase, taking the index from the high bits and
+     * interpolating with the fraction in the low bits.
+     * @param wavetable The wavetable to read.
+     * @param phase The fixed-point phase to read at.
+     * @returns The wavetable value at the phase.
      */
-    void resetWavetable() noexcept;
+    float readWavetable(const float* wavetable, uint32 phase) const noexcept;
 
     /**
-     * Updates the phase delta, which determines the read speed (affecting
-     * the rate).
+     * Adds what is left of the cross-fade offset to a value of the current shape.
+     * @param value The value of the current shape.
+     * @param numSamples The number of samples to advance the cross-fade by.
+     * @returns The LFO value.
      */
-    void updatePhaseDelta() noexcept;
+    float fadeValue(float value, int numSamples) noexcept;
+
+    /**
+     * Computes the next control point of the LFO, advancing the phase by a whole interval.
+     * @param isNoise Whether the shape is the sample-and-hold noise.
+     * @param isFading Whether the cross-fade from the last shape is running.
+     * @returns The LFO value at the control point.
+     */
+    float nextControlValue(bool isNoise, bool isFading) noexcept;
 
-    /** The wavetable, which is an array of float values. */
-    Array<float> m_wavetable;
+    /** The shared wavetables, of which the LFO reads the table of its shape. */
+    SharedResourcePointer<PhantomWavetableStore> m_wavetables;
 
-    AudioProcessorValueTreeState& m_parameters;
+    /** The shared table of the current shape, which is swapped when the shape changes. */
+    const float* m_wavetable = nullptr;
 
-    /** The atomic parameter pointer for the LFO's rate. */
-    std::atomic<float>* p_rate;
+    /** The shape of the table being read. */
+    int m_shape = 0;
 
-    /** The atomic parameter pointer for the LFO's shape. */
-    std::atomic<float>* p_shape;
+    /** Whether the shape was set by `update()` yet (the first shape is read without a cross-fade). */
+    bool m_isShapeSet = false;
 
     /**
-     * The LFO identifier, useful in assigning the correct 
-     * `AudioProcessorValueTreeState` paramteres.
+     * The difference between the output and the new shape when the shape changed, which is 
+     * added to the new shape and faded out.
      */
-    int m_lfoNumber;
+    float m_fadeOffset = 0.0f;
+
+    /** The weight of the cross-fade offset, which falls from 1 to 0 over the cross-fade. */
+    float m_fade = 0.0f;
+
+    /** The amount the weight of the cross-fade offset falls by every sample. */
+    float m_fadeDecrement = 0.0f;
+
+    /** The last value written by `evaluate()`, which a cross-fade starts from. */
+    float m_outputValue = 0.0f;
 
     /**
-     * The sample rate, useful in computing the correct phase delta 
-     * value for a given frequency.
+     * The unique pointer to a `Random` object, which generates the values of the noise shape.
+     * NOTE: Each LFO owns its generator since voices can be rendered on different threads.
      */
-    float m_sampleRate;
+    std::unique_ptr<Random> m_rng;
+
+    /** The parameter values for the current block. */
+    PhantomLFOParameters m_parameters;
 
     /**
-     * The previous shape value, which helps to reduce the
-     * amount of times the wavetable is updated (aka rewritten).
+     * The sample rate, useful in computing the correct phase delta 
+     * value for a given frequency.
      */
-    float m_previousShape;
+    float m_sampleRate;
 
     /**
-     * The phase indicating the current position to read in
-     * computing the next wave value.
+     * The fixed-point phase indicating the current position to read in
+     * computing the next wave value (a full cycle is 2^32, so it wraps on overflow).
      */
-    float m_phase = 0.0f;
+    uint32 m_phase = 0;
 
     /**
-     * The amount to increase the phase by after every wavetable
+     * The amount to increase the fixed-point phase by after every wavetable
      * read, which ultimately determines the wave's frequency.
      */
-    float m_phaseDelta = 0.0f;
+    uint32 m_phaseDelta = 0;
 
-    /** The last read sample value. */
+    /** The last read (or held) value of the current shape. */
     float m_sampleValue = 0.0f;
+
+    /** The unique pointer to the interpolator running the LFO at control rate. */
+    std::unique_ptr<PhantomInterpolator> m_interpolator;
+
+    /** The shape value of the sample-and-hold noise (which reads no wavetable). */
+    const int k_noiseShape = 4;
 };
 
 #endif
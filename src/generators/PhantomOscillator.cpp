@@ -10,124 +10,155 @@
 
 #include "PhantomOscillator.h"
 
+#include "../utils/PhantomMath.h"
 #include "../utils/PhantomUtils.h"
 
-PhantomOscillator::PhantomOscillator(AudioProcessorValueTreeState& vts, int oscNumber) : m_parameters(vts), m_oscNumber(oscNumber)
+PhantomOscillator::PhantomOscillator(const PhantomOscillatorRamps& ramps) : m_ramps(ramps)
 {
-    m_phasor.reset(new PhantomPhasor(m_parameters, m_oscNumber));
+    m_phasor.reset(new PhantomPhasor(m_ramps.phasor));
     m_waveshaper.reset(new PhantomWaveshaper());
-
-    initParameters();
-    initWavetable();
 }
 
 PhantomOscillator::~PhantomOscillator()
 {
     m_phasor = nullptr;
     m_waveshaper = nullptr;
-
-    p_oscRange = nullptr;
-    p_oscCoarseTune = nullptr;
-    p_oscFineTune = nullptr;
-    p_modDepth = nullptr;
-    p_modSource = nullptr;
-    p_shapeInt = nullptr;
-
-    m_wavetable.clear();
 }
 
 void PhantomOscillator::reset()
 {
-    m_phase = 0.0f;
     m_phaseDelta = 0.0f;
+    m_pendingSyncCorrection = 0.0f;
+    m_waveshaper->reset();
 
     m_midiNoteNumber = -1;
     m_frequency = 0.0f;
 }
 
-void PhantomOscillator::initParameters()
+void PhantomOscillator::setInterpolation(PhantomWavetable::Interpolation interpolation) noexcept
+{
+    m_interpolation = interpolation;
+}
+
+void PhantomOscillator::evaluatePhaseDeltas(float* phaseDeltas, const float* oscEgMod, const float* oscLfoMod, int numSamples) noexcept
+{
+    const float* mod = (int) m_parameters.modSource ? oscLfoMod : oscEgMod;
+    const float* modDepth = m_ramps.modDepth.values;
+    const float modExpoThreshold = (float) k_modExpoThreshold;
+    const float phaseDelta = m_frequency * m_phaseDeltaPerHz;
+
+    /** NOTE: Every sample uses the phase delta computed on the sample before it. */
+    float* exponents = phaseDeltas + 1;
+    const int numExponents = numSamples - 1;
+
+    phaseDeltas[0] = m_phaseDelta;
+
+    FloatVectorOperations::multiply(exponents, modDepth, mod, numExponents);
+    FloatVectorOperations::multiply(exponents, modExpoThreshold, numExponents);
+    PhantomMath::exp2(exponents, exponents, numExponents);
+    FloatVectorOperations::multiply(exponents, phaseDelta, numExponents);
+
+    m_phaseDelta = phaseDelta * PhantomMath::exp2(modDepth[numSamples - 1] * modExpoThreshold * mod[numSamples - 1]);
+
+    m_blockPhaseDeltas[0] = phaseDeltas[0];
+    m_blockPhaseDeltas[1] = phaseDeltas[numSamples - 1];
+}
+
+void PhantomOscillator::evaluate(float* dest, const float* phases, const float* phaseEgMod, const float* phaseLfoMod, const float* syncPositions, float* syncPhases, int numSamples) noexcept
 {
-    switch(m_oscNumber)
+    const PhantomWavetable& wavetable = m_wavetables->getOscillatorTable(m_phasor->getShape());
+
+    /** NOTE: The mipmap levels are cross-faded across the block, which follows pitch modulation. */
+    const float startLevel = wavetable.getLevel(m_blockPhaseDeltas[0]);
+    const float endLevel = wavetable.getLevel(m_blockPhaseDeltas[1]);
+
+    m_phasor->evaluateAmounts(dest, phaseEgMod, phaseLfoMod, numSamples);
+
+    if(syncPositions != nullptr)
+        evaluateSyncSteps(syncPhases, syncPositions, dest, wavetable, startLevel, numSamples);
+
+    wavetable.process(dest, phases, dest, startLevel, endLevel, numSamples, m_interpolation);
+
+    dest[0] += m_pendingSyncCorrection;
+    m_pendingSyncCorrection = 0.0f;
+
+    if(syncPositions != nullptr)
+        applySyncBleps(dest, syncPositions, syncPhases, numSamples);
+
+    if(!m_ramps.shapeInt.isSmoothing && m_ramps.shapeInt.value == 0.0f)
     {
-        default:
-        case 1:
-            p_oscRange = m_parameters.getRawParameterValue(Consts::_OSC_01_RANGE_PARAM_ID);
-            p_oscCoarseTune = m_parameters.getRawParameterValue(Consts::_OSC_01_COARSE_TUNE_PARAM_ID);
-            p_oscFineTune = m_parameters.getRawParameterValue(Consts::_OSC_01_FINE_TUNE_PARAM_ID);
-            p_modDepth = m_parameters.getRawParameterValue(Consts::_OSC_01_MOD_DEPTH_PARAM_ID);
-            p_modSource = m_parameters.getRawParameterValue(Consts::_OSC_01_MOD_SOURCE_PARAM_ID);
-            p_shapeInt = m_parameters.getRawParameterValue(Consts::_OSC_01_SHAPE_INT_PARAM_ID);
-            break;
-
-        case 2:
-            p_oscRange = m_parameters.getRawParameterValue(Consts::_OSC_02_RANGE_PARAM_ID);
-            p_oscCoarseTune = m_parameters.getRawParameterValue(Consts::_OSC_02_COARSE_TUNE_PARAM_ID);
-            p_oscFineTune = m_parameters.getRawParameterValue(Consts::_OSC_02_FINE_TUNE_PARAM_ID);
-            p_modDepth = m_parameters.getRawParameterValue(Consts::_OSC_02_MOD_DEPTH_PARAM_ID);
-            p_modSource = m_parameters.getRawParameterValue(Consts::_OSC_02_MOD_SOURCE_PARAM_ID);
-            p_shapeInt = m_parameters.getRawParameterValue(Consts::_OSC_02_SHAPE_INT_PARAM_ID);
-            break;
+        m_waveshaper->reset(dest[numSamples - 1]);
+        return;
     }
+
+    m_waveshaper->atsrADAA(dest, m_ramps.shapeInt.values, numSamples);
 }
 
-void PhantomOscillator::initWavetable()
+void PhantomOscillator::evaluateSyncSteps(float* steps, const float* syncPositions, const float* amounts, const PhantomWavetable& wavetable, float level, int numSamples) const noexcept
 {
-    m_wavetable.clearQuick();
-
-    for (int i = 0; i < Consts::_WAVETABLE_SIZE; i++)
+    for(int i = 0; i < numSamples; i++)
     {
-        float value = cosf(MathConstants<float>::twoPi * (float) i / Consts::_WAVETABLE_SIZE);
-        m_wavetable.insert(i, value);
+        if(syncPositions[i] == 0.0f)
+            continue;
+
+        const float phases[2] = { steps[i], 0.0f };
+        const float sampleAmounts[2] = { amounts[i], amounts[i] };
+        float values[2];
+
+        wavetable.process(values, phases, sampleAmounts, level, level, 2, m_interpolation);
+        steps[i] = values[1] - values[0];
     }
 }
 
-float PhantomOscillator::evaluate(float oscEgMod, float oscLfoMod, float phaseEgMod, float phaseLfoMod) noexcept
+void PhantomOscillator::applySyncBleps(float* dest, const float* syncPositions, const float* steps, int numSamples) noexcept
 {
-    float phase = m_phasor->apply(m_phase, phaseEgMod, phaseLfoMod);
-    float value = m_wavetable[(int) phase];
+    for(int i = 0; i < numSamples; i++)
+    {
+        if(syncPositions[i] == 0.0f)
+            continue;
 
-    m_phase = fmod(m_phase + m_phaseDelta, Consts::_WAVETABLE_SIZE);
+        /** NOTE: `before` is the time from the sample to the reset and `after` from the reset to the next sample. */
+        const float before = syncPositions[i];
+        const float after = 1.0f - before;
 
-    float mod = (int) *p_modSource ? oscLfoMod : oscEgMod;
-    float expo = *p_modDepth * mod * (float) k_modExpoThreshold;
-    updatePhaseDelta(m_frequency * std::exp2f(expo));
+        dest[i] += steps[i] * 0.5f * after * after;
 
-    float shape = m_waveshaper->atsr(value);
-    value = (*p_shapeInt * shape) + ((1.0f - *p_shapeInt) * value);
+        const float nextCorrection = -steps[i] * 0.5f * before * before;
 
-    return value;
+        if(i + 1 < numSamples)
+            dest[i + 1] += nextCorrection;
+        else
+            m_pendingSyncCorrection = nextCorrection;
+    }
 }
 
 float PhantomOscillator::midiNoteToFrequency(float midiNote) noexcept
 {
-    return std::exp((midiNote - 69) * std::log(2) / 12.0f) * 440.0f;
+    return PhantomMath::midiNoteToFrequency(midiNote);
 }
 
-void PhantomOscillator::update(int midiNoteNumber, float sampleRate) noexcept
+void PhantomOscillator::update(const PhantomOscillatorParameters& parameters, int midiNoteNumber, float sampleRate) noexcept
 {
+    m_parameters = parameters;
+    m_phasor->update(m_parameters.phasor);
+
     if(m_midiNoteNumber != midiNoteNumber)
         m_midiNoteNumber = midiNoteNumber;
 
-    m_sampleRate = sampleRate;
+    if(m_sampleRate != sampleRate)
+    {
+        m_sampleRate = sampleRate;
+        m_phaseDeltaPerHz = (float) Consts::_WAVETABLE_SIZE / m_sampleRate;
+    }
 
     updateFrequency();
     updatePhaseDelta();
 }
 
-void PhantomOscillator::updatePhase(float phase) noexcept
-{
-    m_phase = phase;
-}
-
-float PhantomOscillator::readPhase() noexcept
-{
-    return m_phase;
-}
-
 void PhantomOscillator::updateFrequency() noexcept
 {
-    float midiNoteFrequency = midiNoteToFrequency(m_midiNoteNumber + *p_oscCoarseTune + (*p_oscFineTune / 100.0f));
-    float range = std::exp2f((int) *p_oscRange - 2);
+    float midiNoteFrequency = midiNoteToFrequency(m_midiNoteNumber + m_parameters.coarseTune + (m_parameters.fineTune / 100.0f));
+    float range = PhantomMath::exp2((float) ((int) m_parameters.range - 2));
     m_frequency = midiNoteFrequency * range;
 }
 
@@ -138,6 +169,5 @@ void PhantomOscillator::updatePhaseDelta() noexcept
 
 void PhantomOscillator::updatePhaseDelta(float frequency) noexcept
 {
-    float cyclesPerSample = frequency / m_sampleRate;
-    m_phaseDelta = cyclesPerSample * (float) Consts::_WAVETABLE_SIZE;
+    m_phaseDelta = frequency * m_phaseDeltaPerHz;
 }
@@ -15,6 +15,8 @@
 
 #include "../effects/PhantomPhasor.h"
 #include "../effects/PhantomWaveshaper.h"
+#include "PhantomWavetableStore.h"
+#include "../utils/PhantomParameters.h"
 
 /**
  * The audio component for an oscillator, the main "sound generator" 
@@ -25,7 +27,7 @@
 class PhantomOscillator 
 {
 public:
-    PhantomOscillator(AudioProcessorValueTreeState&, int);
+    PhantomOscillator(const PhantomOscillatorRamps&);
     ~PhantomOscillator();
 
     /**
@@ -35,32 +37,41 @@ public:
 
     /**
      * Updates the oscillators parameters.
+     * @param parameters The oscillator's (and phasor's) parameter values for the block.
      * @param midiNoteNumber The pitch value from the note MIDI data.
      * @param sampleRate The sample rate to use in determining the frequency.
      */
-    void update(int midiNoteNumber, float sampleRate) noexcept;
+    void update(const PhantomOscillatorParameters& parameters, int midiNoteNumber, float sampleRate) noexcept;
     
     /**
-     * Update the oscillator's phase specifically.
-     * @param phase The value to use in updating the phase.
+     * Computes the phase delta to advance the phase by at each sample of a block, applying
+     * pitch modulation. The phases themselves are accumulated by the `PhantomVoiceBank`.
+     * @param phaseDeltas The array to write the phase delta values to.
+     * @param oscEgMod The MOD envelope generator modulation values for the oscillator.
+     * @param oscLfoMod The LFO modulation values for the oscillator.
+     * @param numSamples The number of phase delta values to compute.
      */
-    void updatePhase(float phase) noexcept;
+    void evaluatePhaseDeltas(float* phaseDeltas, const float* oscEgMod, const float* oscLfoMod, int numSamples) noexcept;
 
     /**
-     * Reads the oscillator's phase, useful for hard syncing 1+ oscillators.
-     * @returns The current phase value for the oscillator.
+     * Computes the next block of sample values for the oscillator.
+     * @param dest The array to write the sample values to.
+     * @param phases The phase values accumulated from `evaluatePhaseDeltas()`.
+     * @param phaseEgMod The envelope generator modulation values for the phasor.
+     * @param phaseLfoMod The LFO modulation values for the phasor.
+     * @param syncPositions The positions of the hard sync resets (from the voice bank), or `nullptr`
+     * if the oscillator isn't synced.
+     * @param syncPhases The phases interrupted by the hard sync resets (from the voice bank), which are
+     * overwritten. Ignored if `syncPositions` is `nullptr`.
+     * @param numSamples The number of sample values to compute.
      */
-    float readPhase() noexcept;
+    void evaluate(float* dest, const float* phases, const float* phaseEgMod, const float* phaseLfoMod, const float* syncPositions, float* syncPhases, int numSamples) noexcept;
 
     /**
-     * Computes the next sample value for the oscillator.
-     * @param oscEgMod The MOD envelope generator modulation value for the oscillator.
-     * @param oscLfoMod The LFO modulation value for the oscillator.
-     * @param phaseEgMod The envelope generator modulation value for the phasor.
-     * @param phaseLfoMod The LFO modulation value for the phasor.
-     * @returns The next sample value for the oscillator with modulation applied.
+     * Sets the interpolation mode of the wavetable reads.
+     * @param interpolation The interpolation mode to read the wavetable with.
      */
-    float evaluate(float oscEgMod, float oscLfoMod, float phaseEgMod, float phaseLfoMod) noexcept;
+    void setInterpolation(PhantomWavetable::Interpolation interpolation) noexcept;
 
     /**
      * Converts the pitch value from a note's MIDI data to frequency (Hz).
@@ -73,14 +84,27 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomOscillator)
 
     /**
-     * Initializes the `AudioProcessorValueTreeState` oscillator parameters.
+     * Computes the steps of the hard sync resets, from the value at the interrupted phase
+     * to the value at phase 0 (both read with the distortion amount of the sample).
+     * @param steps The interrupted phases, which are overwritten with the steps.
+     * @param syncPositions The positions of the resets (0 where there is no reset).
+     * @param amounts The phase distortion amounts.
+     * @param wavetable The wavetable to read.
+     * @param level The mipmap level to read.
+     * @param numSamples The number of samples.
      */
-    void initParameters();
+    void evaluateSyncSteps(float* steps, const float* syncPositions, const float* amounts, const PhantomWavetable& wavetable, float level, int numSamples) const noexcept;
 
     /**
-     * Initializes the wavetable (only sine).
+     * Band-limits the steps of the hard sync resets with a polynomial BLEP, which corrects the
+     * sample before and the sample after each reset. The correction of a reset after the last
+     * sample of the block is carried over to the first sample of the next block.
+     * @param dest The sample values to correct.
+     * @param syncPositions The positions of the resets (0 where there is no reset).
+     * @param steps The steps of the resets.
+     * @param numSamples The number of samples.
      */
-    void initWavetable();
+    void applySyncBleps(float* dest, const float* syncPositions, const float* steps, int numSamples) noexcept;
 
     /**
      * Update the oscillator's frequency.
@@ -98,8 +122,11 @@ private:
      */
     void updatePhaseDelta(float frequency) noexcept;
 
-    /** The wavetable object, which is just an array of floats. */
-    Array<float> m_wavetable;
+    /** The shared wavetables, of which the oscillator reads the table of its phasor shape. */
+    SharedResourcePointer<PhantomWavetableStore> m_wavetables;
+
+    /** The interpolation mode of the wavetable reads. */
+    PhantomWavetable::Interpolation m_interpolation = PhantomWavetable::CUBIC;
 
     /** The unique pointer to the oscillator's phasor, for applying phase distortion. */
     std::unique_ptr<PhantomPhasor> m_phasor;
@@ -110,41 +137,25 @@ private:
      */
     std::unique_ptr<PhantomWaveshaper> m_waveshaper;
     
-    AudioProcessorValueTreeState& m_parameters;
-
-    /** The atomic parameter pointer for the oscillator's range. */
-    std::atomic<float>* p_oscRange;
-
-    /** The atomic parameter pointer for the oscillator's coarse tune. */
-    std::atomic<float>* p_oscCoarseTune;
-
-    /** The atomic parameter pointer for the oscillator's fine tune. */
-    std::atomic<float>* p_oscFineTune;
-
-    /** The atomic parameter pointer for the oscillator's modulation depth. */
-    std::atomic<float>* p_modDepth;
-
-    /** The atomic parameter pointer for the oscillator's modulation source. */
-    std::atomic<float>* p_modSource;
-
-    /** The atomic parameter pointer for the oscillator's shape intensity. */
-    std::atomic<float>* p_shapeInt;
+    /**
+     * The parameter values for the current block.
+     */
+    PhantomOscillatorParameters m_parameters;
 
     /**
-     * The oscillator identifier, useful in assigning the correct `AudioProcessorValueTreeState` 
-     * parameters.
+     * The smoothed parameters (shape intensity and modulation depth).
      */
-    int m_oscNumber;
+    const PhantomOscillatorRamps& m_ramps;
 
     /** The sampling rate, useful for determining the phase delta / frequency. */
-    float m_sampleRate;
+    float m_sampleRate = 0.0f;
+
+    /** The phase delta for 1 Hz (the reciprocal of the sample rate, in wavetable units). */
+    float m_phaseDeltaPerHz = 0.0f;
 
     /** The maximum exponent value for pitch modulation. */
     const int k_modExpoThreshold = 5;
 
-    /** The phase value which determines the index to read the wavetable at. */
-    float m_phase = 0.0f;
-
     /**
      * The phase delta is the amount to increment the phase after each read, 
      * which ultimately determines the oscillator's output frequency.
@@ -156,6 +167,12 @@ private:
 
     /** The frequency value for the last played (possibly current) note. */
     float m_frequency = 0.0f;
+
+    /** The phase deltas at the start and the end of the last block, which pick the mipmap levels to read. */
+    float m_blockPhaseDeltas[2] = { 0.0f, 0.0f };
+
+    /** The BLEP correction of the first sample of the next block (for a reset after the last sample). */
+    float m_pendingSyncCorrection = 0.0f;
 };
 
 #endif
@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    PhantomWavetable.cpp
+    Created: 17 Oct 2026 19:05:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomWavetable.h"
+
+/** The number of guard points before and after every table. */
+static constexpr int k_numGuardsBefore = 1;
+static constexpr int k_numGuardsAfter = 2;
+
+/** The number of floats held for a table of a level, including its guard points and alignment. */
+static int getLevelStride(int size)
+{
+    const int alignment = (int) dsp::SIMDRegister<float>::SIMDNumElements;
+    return (size + k_numGuardsBefore + k_numGuardsAfter + alignment - 1) / alignment * alignment + alignment;
+}
+
+/** The number of points in a table of a level. */
+static int getLevelSize(int firstLevelSize, int minLevelSize, int level)
+{
+    return jmax(firstLevelSize >> level, minLevelSize);
+}
+
+PhantomWavetable::PhantomWavetable(const PhantomPhasor::WarpCurve& warpCurve, float phaseRange)
+{
+    m_phaseScale = 1.0f / phaseRange;
+
+    int numFloats = 0;
+    for(int level = 0; level < k_numLevels; level++)
+        numFloats += getLevelStride(getLevelSize(k_firstLevelSize, k_minLevelSize, level));
+
+    m_memory.calloc((size_t) (k_numAmounts * numFloats + (int) dsp::SIMDRegister<float>::SIMDNumElements));
+    m_tables.calloc((size_t) (k_numAmounts * k_numLevels));
+
+    float* data = dsp::SIMDRegister<float>::getNextSIMDAlignedPtr(m_memory.get());
+
+    for(int amount = 0; amount < k_numAmounts; amount++)
+    {
+        for(int level = 0; level < k_numLevels; level++)
+        {
+            m_tables[amount * k_numLevels + level] = data + (int) dsp::SIMDRegister<float>::SIMDNumElements;
+            data += getLevelStride(getLevelSize(k_firstLevelSize, k_minLevelSize, level));
+        }
+    }
+
+    initTables(warpCurve);
+}
+
+PhantomWavetable::~PhantomWavetable()
+{
+
+}
+
+void PhantomWavetable::initTables(const PhantomPhasor::WarpCurve& warpCurve)
+{
+    const int fftSize = 1 << k_fftOrder;
+
+    dsp::FFT fft(k_fftOrder);
+
+    HeapBlock<float> spectrum((size_t) (2 * fftSize), true);
+    HeapBlock<float> levelData((size_t) (2 * fftSize), true);
+
+    for(int amount = 0; amount < k_numAmounts; amount++)
+    {
+        const float distortion = (float) amount / (float) (k_numAmounts - 1);
+
+        for(int i = 0; i < fftSize; i++)
+        {
+            const float phase = (float) i / (float) fftSize;
+            const float distortedPhase = PhantomPhasor::evaluate(phase, warpCurve) * distortion + phase * (1.0f - distortion);
+
+            spectrum[i] = cosf(MathConstants<float>::twoPi * distortedPhase);
+        }
+
+        fft.performRealOnlyForwardTransform(spectrum.get());
+
+        for(int level = 0; level < k_numLevels; level++)
+        {
+            const int size = getLevelSize(k_firstLevelSize, k_minLevelSize, level);
+            const int numHarmonics = jmax(1, k_firstLevelHarmonics >> level);
+
+            /** NOTE: Removes every harmonic above the level's bandwidth (and its negative frequency). */
+            FloatVectorOperations::copy(levelData.get(), spectrum.get(), 2 * fftSize);
+            FloatVectorOperations::clear(levelData.get() + 2 * (numHarmonics + 1), 2 * (fftSize - 2 * numHarmonics - 1));
+
+            fft.performRealOnlyInverseTransform(levelData.get());
+
+            float* table = getTable(amount, level);
+            const int step = fftSize / size;
+
+            for(int i = -k_numGuardsBefore; i < size + k_numGuardsAfter; i++)
+                table[i] = levelData[((i + size) % size) * step];
+        }
+    }
+}
+
+float* PhantomWavetable::getTable(int amount, int level) const noexcept
+{
+    return m_tables[amount * k_numLevels + level];
+}
+
+float PhantomWavetable::getLevel(float phaseDelta) const noexcept
+{
+    const float cyclesPerSample = phaseDelta * m_phaseScale;
+
+    if(cyclesPerSample <= 0.0f)
+        return 0.0f;
+
+    /**
+     * NOTE: The highest harmonic of level `L` sits `octaves - L` octaves above Nyquist, so the
+     * level rounded up from `octaves` is the one with the most harmonics that all stay below it.
+     * Its highest harmonic climbs from half of Nyquist to Nyquist over the octave, and it is
+     * read alone until the last `k_levelFadeOctaves` of the octave, where it fades to the next
+     * level (with half the harmonics). Fading over the whole octave instead would mix in the next
+     * level from the start, costing another octave of harmonics on average.
+     */
+    const float octaves = std::log2(cyclesPerSample * (float) (2 * k_firstLevelHarmonics));
+    const float octave = std::floor(octaves);
+    const float fade = jmax(0.0f, (octaves - octave - 1.0f + k_levelFadeOctaves) / k_levelFadeOctaves);
+
+    return jlimit(0.0f, (float) (k_numLevels - 1), octave + 1.0f + fade);
+}
+
+void PhantomWavetable::process(float* dest, const float* phases, const float* amounts, float startLevel, float endLevel, int numSamples, Interpolation interpolation) const noexcept
+{
+    switch(interpolation)
+    {
+        case LINEAR:
+            processBlock<LINEAR>(dest, phases, amounts, startLevel, endLevel, numSamples);
+            break;
+
+        default:
+        case CUBIC:
+            processBlock<CUBIC>(dest, phases, amounts, startLevel, endLevel, numSamples);
+            break;
+    }
+}
+
+/**
+ * Reads a single table.
+ * @param table The first point of the table.
+ * @param size The number of points in the table (a power of two).
+ * @param phase The normalized phase to read at.
+ * @returns The interpolated table value.
+ */
+template <PhantomWavetable::Interpolation Mode>
+static inline float readTable(const float* table, int size, float phase) noexcept
+{
+    const float position = phase * (float) size;
+    const int index = (int) position;
+    const float fraction = position - (float) index;
+    const float* points = table + (index & (size - 1));
+
+    if(Mode == PhantomWavetable::LINEAR)
+        return points[0] + fraction * (points[1] - points[0]);
+
+    const float c1 = 0.5f * (points[1] - points[-1]);
+    const float c2 = points[-1] - 2.5f * points[0] + 2.0f * points[1] - 0.5f * points[2];
+    const float c3 = 0.5f * (points[2] - points[-1]) + 1.5f * (points[0] - points[1]);
+
+    return ((c3 * fraction + c2) * fraction + c1) * fraction + points[0];
+}
+
+template <PhantomWavetable::Interpolation Mode>
+void PhantomWavetable::processBlock(float* dest, const float* phases, const float* amounts, float startLevel, float endLevel, int numSamples) const noexcept
+{
+    const float phaseScale = m_phaseScale;
+    const float maxAmount = (float) (k_numAmounts - 1);
+    const float levelDelta = (endLevel - startLevel) / (float) numSamples;
+
+    float level = startLevel;
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        const float phase = phases[i] * phaseScale;
+
+        const float amountPosition = jlimit(0.0f, maxAmount, amounts[i] * maxAmount);
+        const int amount = jmin((int) amountPosition, k_numAmounts - 2);
+        const float amountFraction = amountPosition - (float) amount;
+
+        const int lowerLevel = jmin((int) level, k_numLevels - 2);
+        const float levelFraction = level - (float) lowerLevel;
+
+        const int lowerSize = getLevelSize(k_firstLevelSize, k_minLevelSize, lowerLevel);
+        const int upperSize = getLevelSize(k_firstLevelSize, k_minLevelSize, lowerLevel + 1);
+
+        const float lower = readTable<Mode>(getTable(amount, lowerLevel), lowerSize, phase);
+        const float upper = readTable<Mode>(getTable(amount, lowerLevel + 1), upperSize, phase);
+        const float nextLower = readTable<Mode>(getTable(amount + 1, lowerLevel), lowerSize, phase);
+        const float nextUpper = readTable<Mode>(getTable(amount + 1, lowerLevel + 1), upperSize, phase);
+
+        const float current = lower + levelFraction * (upper - lower);
+        const float next = nextLower + levelFraction * (nextUpper - nextLower);
+
+        dest[i] = current + amountFraction * (next - current);
+
+        level += levelDelta;
+    }
+}
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    PhantomWavetable.h
+    Created: 17 Oct 2026 19:05:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_WAVETABLE_GENERATOR_H
+#define _PHANTOM_WAVETABLE_GENERATOR_H
+
+#include "JuceHeader.h"
+
+#include "../effects/PhantomPhasor.h"
+
+/**
+ * The band-limited, phase-distorted cosine tables of a phasor shape. Since phase distortion
+ * adds harmonics that a single table can't band-limit, the table is precomputed for a range
+ * of distortion amounts, and each amount is mipmapped with one level per octave (each level
+ * keeping half the harmonics of the one before it). Reads interpolate between the two nearest
+ * amounts and read the level with the most harmonics below Nyquist, cross-fading to the next
+ * level just before its highest harmonic reaches Nyquist, so pitch sweeps move smoothly
+ * through the levels.
+ *
+ * Every table is padded with guard points on both ends (one before, two after) so the
+ * interpolation never wraps an index, which keeps the block kernels free of branches.
+ */
+class PhantomWavetable
+{
+public:
+    /**
+     * Enumerator with the interpolation modes of the table reads.
+     * @property LINEAR Interpolates between the two nearest points.
+     * @property CUBIC Interpolates the four nearest points with a Hermite (Catmull-Rom) spline.
+     */
+    enum Interpolation
+    {
+        LINEAR = 0,
+        CUBIC
+    };
+
+    /**
+     * @param warpCurve The warp curve the tables are distorted with.
+     * @param phaseRange The phase value that corresponds to one full cycle of the table.
+     */
+    PhantomWavetable(const PhantomPhasor::WarpCurve& warpCurve, float phaseRange);
+    ~PhantomWavetable();
+
+    /**
+     * Computes the (fractional) mipmap level to read for a phase delta, which is the lowest
+     * level whose harmonics all stay below Nyquist (or a fade from it to the next level when
+     * its highest harmonic is about to reach Nyquist).
+     * @param phaseDelta The phase delta (in the same units as the phases) of the oscillator.
+     * @returns The mipmap level in the range [0, numLevels - 1].
+     */
+    float getLevel(float phaseDelta) const noexcept;
+
+    /**
+     * Reads a block of table values, cross-fading linearly between the levels at the start
+     * and the end of the block.
+     * NOTE: `dest` may be the same array as `phases` or `amounts`.
+     * @param dest The array to write the table values to.
+     * @param phases The phase values to read at, in the range [0, phaseRange].
+     * @param amounts The phase distortion amounts to read at, in the range [0, 1].
+     * @param startLevel The mipmap level at the start of the block (from `getLevel()`).
+     * @param endLevel The mipmap level at the end of the block (from `getLevel()`).
+     * @param numSamples The number of values to read.
+     * @param interpolation The interpolation mode to read with.
+     */
+    void process(float* dest, const float* phases, const float* amounts, float startLevel, float endLevel, int numSamples, Interpolation interpolation) const noexcept;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomWavetable)
+
+    /**
+     * Computes the spectrum of the phase-distorted cosine for every amount and fills the
+     * mipmap levels from it.
+     * @param warpCurve The warp curve to distort the cosine with.
+     */
+    void initTables(const PhantomPhasor::WarpCurve& warpCurve);
+
+    /**
+     * Reads a block of table values with a fixed interpolation mode.
+     */
+    template <Interpolation Mode>
+    void processBlock(float* dest, const float* phases, const float* amounts, float startLevel, float endLevel, int numSamples) const noexcept;
+
+    /**
+     * @param amount The index of the distortion amount.
+     * @param level The mipmap level.
+     * @returns The SIMD-aligned first point of a table (the guard point before it is at index -1).
+     */
+    float* getTable(int amount, int level) const noexcept;
+
+    /** The memory holding every table and its guard points. */
+    HeapBlock<float> m_memory;
+
+    /** The first point of every table, indexed by `amount * k_numLevels + level`. */
+    HeapBlock<float*> m_tables;
+
+    /** The scale from a phase value to a normalized phase ([0, 1]). */
+    float m_phaseScale = 1.0f;
+
+    /** The number of distortion amounts the tables are computed for (from 0 to 1). */
+    static constexpr int k_numAmounts = 17;
+
+    /** The number of mipmap levels (one per octave). */
+    static constexpr int k_numLevels = 10;
+
+    /** The number of points in the first (full bandwidth) level. */
+    static constexpr int k_firstLevelSize = 1 << 12;
+
+    /** The smallest number of points in a level. */
+    static constexpr int k_minLevelSize = 128;
+
+    /**
+     * The number of harmonics kept by the first level (each level keeps half of the one before).
+     * NOTE: The tables hold eight points per cycle of their highest harmonic, which keeps the images
+     * of the cubic interpolation (folded back below Nyquist) about 65 dB down. Four points per
+     * cycle only kept them 47 dB down for the most distorted shapes. The 512 harmonics of the first
+     * level reach past 20kHz down to about 40Hz, and only notes below that lose their top end.
+     */
+    static constexpr int k_firstLevelHarmonics = k_firstLevelSize / 8;
+
+    /** The part of an octave of pitch (at its top) over which a level fades to the next one. */
+    static constexpr float k_levelFadeOctaves = 0.25f;
+
+    /** The FFT order the distorted cosines are analyzed with. */
+    static constexpr int k_fftOrder = 13;
+};
+
+#endif
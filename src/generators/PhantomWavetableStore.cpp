@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    PhantomWavetableStore.cpp
+    Created: 17 Oct 2026 19:30:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomWavetableStore.h"
+
+#include "../utils/PhantomUtils.h"
+
+PhantomWavetableStore::PhantomWavetableStore()
+{
+    for(int phasorShape = 0; phasorShape < PhantomPhasor::getNumShapes(); phasorShape++)
+        m_oscillatorTables.add(new PhantomWavetable(PhantomPhasor::getWarpCurve(phasorShape), (float) Consts::_WAVETABLE_SIZE));
+
+    const int alignment = (int) dsp::SIMDRegister<float>::SIMDNumElements;
+
+    m_lfoMemory.calloc((size_t) (NUM_LFO_SHAPES * Consts::_WAVETABLE_SIZE + alignment));
+    m_lfoTables = dsp::SIMDRegister<float>::getNextSIMDAlignedPtr(m_lfoMemory.get());
+
+    for(int shape = 0; shape < NUM_LFO_SHAPES; shape++)
+        initLFOTable((LFOShape) shape);
+}
+
+PhantomWavetableStore::~PhantomWavetableStore()
+{
+    m_oscillatorTables.clear();
+    m_lfoTables = nullptr;
+}
+
+const PhantomWavetable& PhantomWavetableStore::getOscillatorTable(int phasorShape) const noexcept
+{
+    return *m_oscillatorTables.getUnchecked(isPositiveAndBelow(phasorShape, m_oscillatorTables.size()) ? phasorShape : 0);
+}
+
+const float* PhantomWavetableStore::getLFOTable(int shape) const noexcept
+{
+    if(shape < 0 || shape >= NUM_LFO_SHAPES)
+        shape = SINE;
+
+    return m_lfoTables + shape * Consts::_WAVETABLE_SIZE;
+}
+
+void PhantomWavetableStore::initLFOTable(LFOShape shape)
+{
+    float* table = m_lfoTables + shape * Consts::_WAVETABLE_SIZE;
+
+    for(int i = 0; i < Consts::_WAVETABLE_SIZE; i++)
+    {
+        float position = (float) i / Consts::_WAVETABLE_SIZE;
+
+        switch(shape)
+        {
+            default:
+            case SINE:
+                table[i] = sinf(MathConstants<float>::twoPi * position);
+                break;
+
+            case TRIANGLE:
+                table[i] = 2.0f * std::abs(position * 2.0f - 1.0f) - 1.0f;
+                break;
+
+            case SAWTOOTH:
+                table[i] = position * 2.0f - 1.0f;
+                break;
+
+            case SQUARE:
+                table[i] = position <= 0.5f ? 1.0f : -1.0f;
+                break;
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    PhantomWavetableStore.h
+    Created: 17 Oct 2026 19:30:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_WAVETABLE_STORE_GENERATOR_H
+#define _PHANTOM_WAVETABLE_STORE_GENERATOR_H
+
+#include "JuceHeader.h"
+
+#include "PhantomWavetable.h"
+
+/**
+ * The immutable wavetables shared by every oscillator and LFO of every plugin instance.
+ * Hold it with a `SharedResourcePointer<PhantomWavetableStore>`, which builds the tables
+ * when the first holder is created and frees them once the last holder is gone.
+ * NOTE: Building the oscillator tables takes a few FFTs per table, so the synth holds the
+ * store for its whole lifetime, which keeps the tables alive while its voices are recreated.
+ */
+class PhantomWavetableStore
+{
+public:
+    PhantomWavetableStore();
+    ~PhantomWavetableStore();
+
+    /**
+     * Enumerator with the LFO shapes that read a wavetable (the noise shape doesn't).
+     */
+    enum LFOShape
+    {
+        SINE = 0,
+        TRIANGLE,
+        SAWTOOTH,
+        SQUARE,
+        NUM_LFO_SHAPES
+    };
+
+    /**
+     * @param phasorShape The phasor shape parameter value (out of range values return the first shape).
+     * @returns The band-limited, phase-distorted cosine tables read by the oscillators.
+     */
+    const PhantomWavetable& getOscillatorTable(int phasorShape) const noexcept;
+
+    /**
+     * @param shape The LFO shape parameter value (the noise shape returns the sine table).
+     * @returns The `Consts::_WAVETABLE_SIZE` values of the LFO table.
+     */
+    const float* getLFOTable(int shape) const noexcept;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomWavetableStore)
+
+    /**
+     * Fills the table of an LFO shape.
+     * @param shape The LFO shape to fill the table of.
+     */
+    void initLFOTable(LFOShape shape);
+
+    /** The oscillator tables, one for each phasor shape (warp curve). */
+    OwnedArray<PhantomWavetable> m_oscillatorTables;
+
+    /** The memory holding the LFO tables (with room for alignment). */
+    HeapBlock<float> m_lfoMemory;
+
+    /** The SIMD-aligned start of the LFO tables, one after the other. */
+    float* m_lfoTables = nullptr;
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    PhantomAudioTap.cpp
+    Created: 17 Oct 2026 18:40:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomAudioTap.h"
+
+PhantomAudioTap::PhantomAudioTap(int capacity) : m_fifo(capacity), m_buffer(1, capacity)
+{
+    m_buffer.clear();
+}
+
+PhantomAudioTap::~PhantomAudioTap()
+{
+
+}
+
+void PhantomAudioTap::push(const AudioBuffer<float>& buffer) noexcept
+{
+    if(!m_isReaderAttached.load() || buffer.getNumChannels() == 0)
+        return;
+
+    int start1, size1, start2, size2;
+    m_fifo.prepareToWrite(buffer.getNumSamples(), start1, size1, start2, size2);
+
+    const float* reader = buffer.getReadPointer(0);
+    float* writer = m_buffer.getWritePointer(0);
+
+    if(size1 > 0)
+        FloatVectorOperations::copy(writer + start1, reader, size1);
+
+    if(size2 > 0)
+        FloatVectorOperations::copy(writer + start2, reader + size1, size2);
+
+    m_fifo.finishedWrite(size1 + size2);
+}
+
+int PhantomAudioTap::pull(float* dest, int maxNumSamples) noexcept
+{
+    int start1, size1, start2, size2;
+    m_fifo.prepareToRead(maxNumSamples, start1, size1, start2, size2);
+
+    const float* reader = m_buffer.getReadPointer(0);
+
+    if(size1 > 0)
+        FloatVectorOperations::copy(dest, reader + start1, size1);
+
+    if(size2 > 0)
+        FloatVectorOperations::copy(dest + size1, reader + start2, size2);
+
+    m_fifo.finishedRead(size1 + size2);
+
+    return size1 + size2;
+}
+
+void PhantomAudioTap::setReaderAttached(bool isAttached) noexcept
+{
+    /** NOTE: Only the read position moves, which the reader owns, so this is safe while the audio thread pushes. */
+    if(isAttached)
+        m_fifo.finishedRead(m_fifo.getNumReady());
+
+    m_isReaderAttached.store(isAttached);
+}
@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+    PhantomAudioTap.h
+    Created: 17 Oct 2026 18:40:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_AUDIO_TAP_H
+#define _PHANTOM_AUDIO_TAP_H
+
+#include "JuceHeader.h"
+
+/**
+ * A lock-free single-producer single-consumer ring buffer of the synth's output for the
+ * visualizers. The audio thread pushes the blocks while a reader (the editor) is attached, and
+ * the reader pulls the samples on the message thread, so the audio thread never touches a component.
+ * NOTE: Samples that don't fit are dropped, which only happens when the reader falls behind.
+ */
+class PhantomAudioTap
+{
+public:
+    PhantomAudioTap(int capacity);
+    ~PhantomAudioTap();
+
+    /**
+     * Copies the first channel of a block into the ring buffer.
+     * CAUTION: This must only be called from the audio thread.
+     * @param buffer The block to copy.
+     */
+    void push(const AudioBuffer<float>& buffer) noexcept;
+
+    /**
+     * Copies the oldest samples out of the ring buffer.
+     * CAUTION: This must only be called from a single reader thread (the message thread).
+     * @param dest The array to copy the samples to.
+     * @param maxNumSamples The largest number of samples to copy.
+     * @returns The number of samples copied.
+     */
+    int pull(float* dest, int maxNumSamples) noexcept;
+
+    /**
+     * Attaches or detaches the reader. Attaching discards the samples left over from the last
+     * reader, so a reopened editor starts from the current output instead of a stale one.
+     * CAUTION: This must only be called from the reader thread (the message thread).
+     * @param isAttached Whether a reader is pulling the samples.
+     */
+    void setReaderAttached(bool isAttached) noexcept;
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomAudioTap)
+
+    /** The read and write positions of the ring buffer. */
+    AbstractFifo m_fifo;
+
+    /** The samples of the ring buffer. */
+    AudioBuffer<float> m_buffer;
+
+    /** Whether a reader is pulling the samples, without which nothing is pushed. */
+    std::atomic<bool> m_isReaderAttached { false };
+};
+
+#endif
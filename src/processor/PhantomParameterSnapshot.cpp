@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    PhantomParameterSnapshot.cpp
+    Created: 17 Oct 2026 16:20:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomParameterSnapshot.h"
+
+#include "../utils/PhantomUtils.h"
+
+PhantomParameterSnapshot::PhantomParameterSnapshot(AudioProcessorValueTreeState& vts) : m_parameters(vts)
+{
+    bind(Consts::_LEVEL_PARAM_ID, m_values.amp.level);
+
+    bind(Consts::_POLYPHONY_PARAM_ID, m_values.polyphony);
+    bind(Consts::_VOICE_STEAL_PARAM_ID, m_values.voiceSteal);
+
+    bind(Consts::_OSC_SYNC_PARAM_ID, m_values.oscSync);
+
+    bind(Consts::_MOD_RATE_PARAM_ID, m_values.modRate);
+    bind(Consts::_AMP_EG_AUDIO_RATE_PARAM_ID, m_values.ampEgAudioRate);
+    bind(Consts::_OSC_INTERPOLATION_PARAM_ID, m_values.oscInterpolation);
+
+    bind(Consts::_OSC_01_RANGE_PARAM_ID, m_values.osc[0].range);
+    bind(Consts::_OSC_01_COARSE_TUNE_PARAM_ID, m_values.osc[0].coarseTune);
+    bind(Consts::_OSC_01_FINE_TUNE_PARAM_ID, m_values.osc[0].fineTune);
+    bind(Consts::_OSC_01_SHAPE_INT_PARAM_ID, m_values.osc[0].shapeInt);
+    bind(Consts::_OSC_01_MOD_DEPTH_PARAM_ID, m_values.osc[0].modDepth);
+    bind(Consts::_OSC_01_MOD_SOURCE_PARAM_ID, m_values.osc[0].modSource);
+
+    bind(Consts::_OSC_02_RANGE_PARAM_ID, m_values.osc[1].range);
+    bind(Consts::_OSC_02_COARSE_TUNE_PARAM_ID, m_values.osc[1].coarseTune);
+    bind(Consts::_OSC_02_FINE_TUNE_PARAM_ID, m_values.osc[1].fineTune);
+    bind(Consts::_OSC_02_SHAPE_INT_PARAM_ID, m_values.osc[1].shapeInt);
+    bind(Consts::_OSC_02_MOD_DEPTH_PARAM_ID, m_values.osc[1].modDepth);
+    bind(Consts::_OSC_02_MOD_SOURCE_PARAM_ID, m_values.osc[1].modSource);
+
+    bind(Consts::_PHASOR_01_SHAPE_PARAM_ID, m_values.osc[0].phasor.shape);
+    bind(Consts::_PHASOR_01_EG_INT_PARAM_ID, m_values.osc[0].phasor.egInt);
+    bind(Consts::_PHASOR_01_LFO_INT_PARAM_ID, m_values.osc[0].phasor.lfoInt);
+
+    bind(Consts::_PHASOR_02_SHAPE_PARAM_ID, m_values.osc[1].phasor.shape);
+    bind(Consts::_PHASOR_02_EG_INT_PARAM_ID, m_values.osc[1].phasor.egInt);
+    bind(Consts::_PHASOR_02_LFO_INT_PARAM_ID, m_values.osc[1].phasor.lfoInt);
+
+    bind(Consts::_MIXER_OSC_BAL_PARAM_ID, m_values.mixer.oscBalance);
+    bind(Consts::_MIXER_AMP_GAIN_PARAM_ID, m_values.mixer.ampGain);
+    bind(Consts::_MIXER_RING_MOD_PARAM_ID, m_values.mixer.ringMod);
+    bind(Consts::_MIXER_NOISE_PARAM_ID, m_values.mixer.noise);
+
+    bind(Consts::_FLTR_CUTOFF_PARAM_ID, m_values.filter.cutoff);
+    bind(Consts::_FLTR_RESO_PARAM_ID, m_values.filter.resonance);
+    bind(Consts::_FLTR_DRIVE_PARAM_ID, m_values.filter.drive);
+    bind(Consts::_FLTR_MODE_PARAM_ID, m_values.filter.mode);
+    bind(Consts::_FLTR_EG_MOD_DEPTH_PARAM_ID, m_values.filter.egModDepth);
+    bind(Consts::_FLTR_LFO_MOD_DEPTH_PARAM_ID, m_values.filter.lfoModDepth);
+
+    bind(Consts::_LFO_01_RATE_PARAM_ID, m_values.lfo[0].rate);
+    bind(Consts::_LFO_01_SHAPE_PARAM_ID, m_values.lfo[0].shape);
+    bind(Consts::_LFO_01_MODE_PARAM_ID, m_values.lfo[0].mode);
+
+    bind(Consts::_LFO_02_RATE_PARAM_ID, m_values.lfo[1].rate);
+    bind(Consts::_LFO_02_SHAPE_PARAM_ID, m_values.lfo[1].shape);
+    bind(Consts::_LFO_02_MODE_PARAM_ID, m_values.lfo[1].mode);
+
+    bind(Consts::_AMP_EG_ATK_PARAM_ID, m_values.eg[EnvelopeType::AMP].attack);
+    bind(Consts::_AMP_EG_DEC_PARAM_ID, m_values.eg[EnvelopeType::AMP].decay);
+    bind(Consts::_AMP_EG_SUS_PARAM_ID, m_values.eg[EnvelopeType::AMP].sustain);
+    bind(Consts::_AMP_EG_REL_PARAM_ID, m_values.eg[EnvelopeType::AMP].release);
+
+    bind(Consts::_PHASOR_EG_ATK_PARAM_ID, m_values.eg[EnvelopeType::PHASOR].attack);
+    bind(Consts::_PHASOR_EG_DEC_PARAM_ID, m_values.eg[EnvelopeType::PHASOR].decay);
+    bind(Consts::_PHASOR_EG_SUS_PARAM_ID, m_values.eg[EnvelopeType::PHASOR].sustain);
+    bind(Consts::_PHASOR_EG_REL_PARAM_ID, m_values.eg[EnvelopeType::PHASOR].release);
+
+    bind(Consts::_FLTR_EG_ATK_PARAM_ID, m_values.eg[EnvelopeType::FILTER].attack);
+    bind(Consts::_FLTR_EG_DEC_PARAM_ID, m_values.eg[EnvelopeType::FILTER].decay);
+    bind(Consts::_FLTR_EG_SUS_PARAM_ID, m_values.eg[EnvelopeType::FILTER].sustain);
+    bind(Consts::_FLTR_EG_REL_PARAM_ID, m_values.eg[EnvelopeType::FILTER].release);
+
+    bind(Consts::_MOD_EG_ATK_PARAM_ID, m_values.eg[EnvelopeType::MOD].attack);
+    bind(Consts::_MOD_EG_DEC_PARAM_ID, m_values.eg[EnvelopeType::MOD].decay);
+    bind(Consts::_MOD_EG_SUS_PARAM_ID, m_values.eg[EnvelopeType::MOD].sustain);
+    bind(Consts::_MOD_EG_REL_PARAM_ID, m_values.eg[EnvelopeType::MOD].release);
+
+    update();
+}
+
+PhantomParameterSnapshot::~PhantomParameterSnapshot()
+{
+    m_bindings.clear();
+}
+
+void PhantomParameterSnapshot::bind(const char* parameterId, float& value)
+{
+    std::atomic<float>* parameter = m_parameters.getRawParameterValue(parameterId);
+    jassert(parameter != nullptr);
+
+    m_bindings.add({ parameter, &value });
+}
+
+void PhantomParameterSnapshot::update() noexcept
+{
+    for(const Binding& binding : m_bindings)
+        *binding.value = binding.parameter->load(std::memory_order_relaxed);
+}
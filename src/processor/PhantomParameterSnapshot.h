@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    PhantomParameterSnapshot.h
+    Created: 17 Oct 2026 16:20:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_PARAMETER_SNAPSHOT_H
+#define _PHANTOM_PARAMETER_SNAPSHOT_H
+
+#include "JuceHeader.h"
+
+#include "../utils/PhantomParameters.h"
+
+/**
+ * Reads every parameter of the `AudioProcessorValueTreeState` into a `PhantomParameters`
+ * struct, so the atomics are loaded once per block instead of by every stage of every voice.
+ */
+class PhantomParameterSnapshot
+{
+public:
+    PhantomParameterSnapshot(AudioProcessorValueTreeState&);
+    ~PhantomParameterSnapshot();
+
+    /**
+     * Loads the current value of every parameter, called once at the start of a block.
+     */
+    void update() noexcept;
+
+    /**
+     * @returns The parameter values loaded by the last `update()`.
+     */
+    const PhantomParameters& get() const noexcept { return m_values; };
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomParameterSnapshot)
+
+    /**
+     * Binds a parameter to the field of the snapshot its value is loaded into.
+     * @param parameterId The ID of the parameter.
+     * @param value The field of `m_values` to load the parameter into.
+     */
+    void bind(const char* parameterId, float& value);
+
+    /**
+     * A parameter and the field of the snapshot it is loaded into.
+     */
+    struct Binding
+    {
+        std::atomic<float>* parameter;
+        float* value;
+    };
+
+    AudioProcessorValueTreeState& m_parameters;
+
+    /** The bindings for every parameter of the layout. */
+    Array<Binding> m_bindings;
+
+    /** The parameter values for the current block. */
+    PhantomParameters m_values;
+};
+
+#endif
@@ -230,6 +230,70 @@ AudioProcessorValueTreeState::ParameterLayout CreateParameterLayout()
     );
     params.push_back(std::move(level));
 
+    // VOICES
+    auto polyphony = std::make_unique<AudioParameterFloat>(
+        Consts::_POLYPHONY_PARAM_ID, Consts::_POLYPHONY_PARAM_NAME,
+        NormalisableRange<float>(1.0f, (float) Consts::_MAX_POLYPHONY, 1.0f),
+        Consts::_POLYPHONY_DEFAULT_VAL
+    );
+    params.push_back(std::move(polyphony));
+
+    auto voiceSteal = std::make_unique<AudioParameterFloat>(
+        Consts::_VOICE_STEAL_PARAM_ID, Consts::_VOICE_STEAL_PARAM_NAME,
+        NormalisableRange<float>(0.0f, 2.0f, 1.0f),
+        Consts::_VOICE_STEAL_DEFAULT_VAL
+    );
+    params.push_back(std::move(voiceSteal));
+
+    // ENGINE
+    /**
+     * NOTE: The engine settings aren't automatable. Oversampling and multi-core rendering re-prepare the
+     * synth (cutting every note) and the others change how the voices are computed, not how they sound.
+     */
+
+    /** NOTE: The choice index is the power of two of the oversampling factor (1x, 2x, 4x or 8x). */
+    auto oversampling = std::make_unique<AudioParameterChoice>(
+        Consts::_OVERSAMPLING_PARAM_ID, Consts::_OVERSAMPLING_PARAM_NAME,
+        StringArray({ "1x", "2x", "4x", "8x" }),
+        (int) Consts::_OVERSAMPLING_DEFAULT_VAL,
+        AudioParameterChoiceAttributes().withAutomatable(false)
+    );
+    params.push_back(std::move(oversampling));
+
+    auto multiCore = std::make_unique<AudioParameterFloat>(
+        Consts::_MULTI_CORE_PARAM_ID, Consts::_MULTI_CORE_PARAM_NAME,
+        NormalisableRange<float>(0.0f, 1.0f, 1.0f),
+        Consts::_MULTI_CORE_DEFAULT_VAL,
+        AudioParameterFloatAttributes().withAutomatable(false)
+    );
+    params.push_back(std::move(multiCore));
+
+    /** NOTE: The choice index selects the number of samples between computed modulation values (1, 8, 16 or 32). */
+    auto modRate = std::make_unique<AudioParameterChoice>(
+        Consts::_MOD_RATE_PARAM_ID, Consts::_MOD_RATE_PARAM_NAME,
+        StringArray({ "Audio", "8 Samples", "16 Samples", "32 Samples" }),
+        (int) Consts::_MOD_RATE_DEFAULT_VAL,
+        AudioParameterChoiceAttributes().withAutomatable(false)
+    );
+    params.push_back(std::move(modRate));
+
+    auto ampEgAudioRate = std::make_unique<AudioParameterFloat>(
+        Consts::_AMP_EG_AUDIO_RATE_PARAM_ID, Consts::_AMP_EG_AUDIO_RATE_PARAM_NAME,
+        NormalisableRange<float>(0.0f, 1.0f, 1.0f),
+        Consts::_AMP_EG_AUDIO_RATE_DEFAULT_VAL,
+        AudioParameterFloatAttributes().withAutomatable(false)
+    );
+    params.push_back(std::move(ampEgAudioRate));
+
+    /** NOTE: The choice index is the `PhantomWavetable::Interpolation` mode. */
+    auto oscInterpolation = std::make_unique<AudioParameterChoice>(
+        Consts::_OSC_INTERPOLATION_PARAM_ID, Consts::_OSC_INTERPOLATION_PARAM_NAME,
+        StringArray({ "Linear", "Cubic" }),
+        (int) Consts::_OSC_INTERPOLATION_DEFAULT_VAL,
+        AudioParameterChoiceAttributes().withAutomatable(false)
+    );
+    params.push_back(std::move(oscInterpolation));
+
     // OSCILLATORs
     auto oscSync = std::make_unique<AudioParameterFloat>(
         Consts::_OSC_SYNC_PARAM_ID, Consts::_OSC_SYNC_PARAM_NAME,
@@ -397,7 +461,7 @@ AudioProcessorValueTreeState::ParameterLayout CreateParameterLayout()
     // FILTER
     auto filterMode = std::make_unique<AudioParameterFloat>(
         Consts::_FLTR_MODE_PARAM_ID, Consts::_FLTR_MODE_PARAM_NAME,
-        NormalisableRange<float>(0.0f, 2.0f, 1.0f),
+        NormalisableRange<float>(0.0f, 3.0f, 1.0f),
         Consts::_FLTR_MODE_DEFAULT_VAL
     );
     params.push_back(std::move(filterMode));
@@ -452,6 +516,13 @@ AudioProcessorValueTreeState::ParameterLayout CreateParameterLayout()
     );
     params.push_back(std::move(lfo01Shape));
 
+    auto lfo01Mode = std::make_unique<AudioParameterFloat>(
+        Consts::_LFO_01_MODE_PARAM_ID, Consts::_LFO_01_MODE_PARAM_NAME,
+        NormalisableRange<float>(0.0f, 1.0f, 1.0f),
+        Consts::_LFO_01_MODE_DEFAULT_VAL
+    );
+    params.push_back(std::move(lfo01Mode));
+
     auto lfo02Rate = std::make_unique<AudioParameterFloat>(
         Consts::_LFO_02_RATE_PARAM_ID, Consts::_LFO_02_RATE_PARAM_NAME,
         NormalisableRange<float>(0.1f, 100.0f, 0.01f, calculateSkewFactor(0.1f, 100.0f, 20.0f), false),
@@ -466,6 +537,13 @@ AudioProcessorValueTreeState::ParameterLayout CreateParameterLayout()
     );
     params.push_back(std::move(lfo02Shape));
 
+    auto lfo02Mode = std::make_unique<AudioParameterFloat>(
+        Consts::_LFO_02_MODE_PARAM_ID, Consts::_LFO_02_MODE_PARAM_NAME,
+        NormalisableRange<float>(0.0f, 1.0f, 1.0f),
+        Consts::_LFO_02_MODE_DEFAULT_VAL
+    );
+    params.push_back(std::move(lfo02Mode));
+
     // EGs
     auto ampEgAtk = std::make_unique<AudioParameterFloat>(
         Consts::_AMP_EG_ATK_PARAM_ID, Consts::_AMP_EG_ATK_PARAM_NAME,
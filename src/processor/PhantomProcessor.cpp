@@ -10,6 +10,15 @@
 #include "../editor/PhantomEditor.h"
 #include "../utils/PhantomData.h"
 
+/**
+ * The parameters that configure the synth engine, which are applied by re-preparing the synth.
+ * NOTE: The other engine settings are read from the parameter snapshot and applied live by the synth.
+ */
+static const char* const k_engineParameterIDs[] = {
+    Consts::_OVERSAMPLING_PARAM_ID,
+    Consts::_MULTI_CORE_PARAM_ID
+};
+
 PhantomAudioProcessor::PhantomAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
      :  m_parameters(*this, nullptr, Identifier("Phantom"), CreateParameterLayout()),
@@ -23,18 +32,32 @@ PhantomAudioProcessor::PhantomAudioProcessor()
                        )
 #endif
 {
+    m_parameterSnapshot = std::make_unique<PhantomParameterSnapshot>(m_parameters);
     m_presetManager = std::make_unique<PhantomPresetManager>(m_parameters);
 
-    m_synth = std::make_unique<PhantomSynth>(m_parameters);
-    m_amp = std::make_unique<PhantomAmplifier>(m_parameters);
+    m_synth = std::make_unique<PhantomSynth>();
+    m_amp = std::make_unique<PhantomAmplifier>();
+
+    m_audioTap = std::make_unique<PhantomAudioTap>(k_audioTapSize);
+
+    for(auto* parameterID : k_engineParameterIDs)
+        m_parameters.addParameterListener(parameterID, this);
 }
 
 PhantomAudioProcessor::~PhantomAudioProcessor()
 {
+    for(auto* parameterID : k_engineParameterIDs)
+        m_parameters.removeParameterListener(parameterID, this);
+
+    cancelPendingUpdate();
+
     m_presetManager = nullptr;
 
     m_synth = nullptr;
     m_amp = nullptr;
+
+    m_audioTap = nullptr;
+    m_parameterSnapshot = nullptr;
 }
 
 const String PhantomAudioProcessor::getName() const
@@ -100,8 +123,18 @@ void PhantomAudioProcessor::changeProgramName(int index, const String& newName)
 
 void PhantomAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    int numChannels = jmin(getMainBusNumInputChannels(), getMainBusNumOutputChannels());
+    int numChannels = getMainBusNumOutputChannels();
+
+    /** NOTE: The smoothers start at the current parameter values instead of ramping from the defaults. */
+    m_parameterSnapshot->update();
+    m_synth->update(m_parameterSnapshot->get());
+    m_amp->update(m_parameterSnapshot->get().amp);
+
+    updateEngineSettings();
     m_synth->init((float) sampleRate, samplesPerBlock, numChannels);
+    m_amp->prepare((float) sampleRate, samplesPerBlock);
+
+    setLatencySamples(m_synth->getLatencyInSamples());
 }
 
 void PhantomAudioProcessor::releaseResources()
@@ -140,15 +173,16 @@ void PhantomAudioProcessor::processBlock(AudioBuffer<float>& buffer, MidiBuffer&
 {
     buffer.clear();
 
+    m_parameterSnapshot->update();
+    const PhantomParameters& parameters = m_parameterSnapshot->get();
+
+    m_synth->update(parameters);
+    m_amp->update(parameters.amp);
+
     m_synth->renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
     m_amp->apply(buffer);
 
-    PhantomAudioProcessorEditor* editor = static_cast<PhantomAudioProcessorEditor*>(getActiveEditor());
-    if(editor)
-    {
-        editor->m_phantomOscilloscope->pushBuffer(buffer);
-        editor->m_phantomAnalyzer->pushBuffer(buffer);
-    }
+    m_audioTap->push(buffer);
 }
 
 bool PhantomAudioProcessor::hasEditor() const
@@ -180,6 +214,52 @@ PhantomPresetManager& PhantomAudioProcessor::getPresetManager()
     return *m_presetManager;
 }
 
+PhantomAudioTap& PhantomAudioProcessor::getAudioTap()
+{
+    return *m_audioTap;
+}
+
+void PhantomAudioProcessor::parameterChanged(const String& parameterID, float newValue)
+{
+    triggerAsyncUpdate();
+}
+
+void PhantomAudioProcessor::handleAsyncUpdate()
+{
+    applyEngineSettings();
+}
+
+int PhantomAudioProcessor::getOversamplingFactor() const noexcept
+{
+    return 1 << jlimit(0, 3, (int) m_parameters.getRawParameterValue(Consts::_OVERSAMPLING_PARAM_ID)->load());
+}
+
+bool PhantomAudioProcessor::updateEngineSettings() noexcept
+{
+    const int oversamplingFactor = getOversamplingFactor();
+    const bool isMultiCoreRendering = m_parameters.getRawParameterValue(Consts::_MULTI_CORE_PARAM_ID)->load() != 0.0f;
+
+    if(oversamplingFactor == m_synth->getOversamplingFactor()
+        && isMultiCoreRendering == m_synth->isMultiCoreRendering())
+        return false;
+
+    m_synth->setOversamplingFactor(oversamplingFactor);
+    m_synth->setMultiCoreRendering(isMultiCoreRendering);
+
+    return true;
+}
+
+void PhantomAudioProcessor::applyEngineSettings()
+{
+    /** NOTE: The oversampling factor is read while rendering, so the settings are only copied once the processing is suspended. */
+    suspendProcessing(true);
+
+    if(updateEngineSettings() && getSampleRate() > 0.0)
+        prepareToPlay(getSampleRate(), getBlockSize());
+
+    suspendProcessing(false);
+}
+
 AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new PhantomAudioProcessor();
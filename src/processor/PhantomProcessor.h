@@ -11,6 +11,8 @@
 #include "JuceHeader.h"
 
 #include "../effects/PhantomAmplifier.h"
+#include "PhantomAudioTap.h"
+#include "PhantomParameterSnapshot.h"
 #include "PhantomSynth.h"
 #include "PhantomPresetManager.h"
 #include "../utils/PhantomUtils.h"
@@ -19,7 +21,9 @@
  * The audio processor component, containing the important JUCE boilerplate 
  * code for the plugin.
  */
-class PhantomAudioProcessor : public AudioProcessor
+class PhantomAudioProcessor : public AudioProcessor,
+                              private AudioProcessorValueTreeState::Listener,
+                              private AsyncUpdater
 {
 public:
     PhantomAudioProcessor();
@@ -128,14 +132,57 @@ public:
      */
     PhantomPresetManager& getPresetManager();
 
+    /**
+     * Corresponds to the tap of the processor's output, which the visualizers read from.
+     * @returns A reference of the audio tap object.
+     */
+    PhantomAudioTap& getAudioTap();
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomAudioProcessor)
 
+    /**
+     * Called (from any thread) when an engine parameter changes, which defers the 
+     * re-preparation of the synth to the message thread.
+     * @param parameterID The ID of the parameter that changed.
+     * @param newValue The new value of the parameter.
+     */
+    void parameterChanged(const String& parameterID, float newValue) override;
+
+    /**
+     * Applies the engine parameters on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    /**
+     * @returns The oversampling factor (1, 2, 4 or 8) selected by the oversampling parameter.
+     */
+    int getOversamplingFactor() const noexcept;
+
+    /**
+     * Copies the engine parameters that need a new `init()` (oversampling and multi-core rendering)
+     * to the synth, which applies them on its next `init()`.
+     * @returns `true` if any of them changed.
+     */
+    bool updateEngineSettings() noexcept;
+
+    /**
+     * Applies the engine parameters, suspending and re-preparing the processor (and reporting
+     * the new latency to the host) if any of them changed while it is playing.
+     * NOTE: This must be called from the message thread, as it allocates.
+     */
+    void applyEngineSettings();
+
     /**
      * The object holding all of the plugin state date (aka parameter values).
      */
     AudioProcessorValueTreeState m_parameters;
 
+    /**
+     * The snapshot of the parameter values, read once at the start of every block.
+     */
+    std::unique_ptr<PhantomParameterSnapshot> m_parameterSnapshot;
+
     /**
      * The preset manager responsible for all things preset-related (non-GUI).
      */
@@ -151,6 +198,16 @@ private:
      * has written its data.
      */
     std::unique_ptr<PhantomAmplifier> m_amp;
+
+    /**
+     * The tap that every processed block is pushed to for the visualizers.
+     */
+    std::unique_ptr<PhantomAudioTap> m_audioTap;
+
+    /**
+     * The number of samples the audio tap can hold between reads of the editor.
+     */
+    const int k_audioTapSize = 1 << 14;
 };
 
 #endif
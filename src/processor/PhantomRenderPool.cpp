@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    PhantomRenderPool.cpp
+    Created: 17 Oct 2026 13:40:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomRenderPool.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+
+std::atomic<int> PhantomRenderPool::s_numProcessWorkers { 0 };
+
+PhantomRenderPool::PhantomRenderPool(Job& job, int numWorkers) : m_job(job)
+{
+    numWorkers = reserveWorkers(numWorkers);
+
+    for(int i = 0; i < numWorkers; i++)
+    {
+        Worker* worker = m_workers.add(new Worker(*this, i + 1));
+        worker->startRealtimeThread(Thread::RealtimeOptions{}.withPriority(10));
+    }
+}
+
+PhantomRenderPool::~PhantomRenderPool()
+{
+    for(auto* worker : m_workers)
+        worker->signalThreadShouldExit();
+
+    for(auto* worker : m_workers)
+        worker->stopThread(1000);
+
+    s_numProcessWorkers.fetch_sub(m_workers.size());
+    m_workers.clear();
+}
+
+void PhantomRenderPool::render(int numGroups) noexcept
+{
+    m_numGroups.store(numGroups);
+    m_nextGroup.store(0);
+
+    m_isJobOpen.store(true);
+    m_generation.fetch_add(1);
+
+    renderClaimedGroups();
+
+    m_isJobOpen.store(false);
+
+    /**
+     * NOTE: Every group has been claimed at this point, so this only waits for the workers
+     * that are still rendering their last group (or leaving a job they arrived too late for).
+     */
+    for(int numPolls = 0; m_numActiveWorkers.load() > 0; numPolls++)
+    {
+        if(numPolls < k_numWaitPolls)
+            pause();
+        else
+            Thread::yield();
+    }
+}
+
+void PhantomRenderPool::renderClaimedGroups() noexcept
+{
+    const int numGroups = m_numGroups.load();
+
+    for(int group = m_nextGroup.fetch_add(1); group < numGroups; group = m_nextGroup.fetch_add(1))
+        m_job.renderJobGroup(group);
+}
+
+int PhantomRenderPool::reserveWorkers(int numWorkers) noexcept
+{
+    const int maxNumProcessWorkers = jmax(0, SystemStats::getNumPhysicalCpus() / 2 - 1);
+
+    int numProcessWorkers = s_numProcessWorkers.load();
+    int numReserved = 0;
+
+    do
+    {
+        numReserved = jlimit(0, numWorkers, maxNumProcessWorkers - numProcessWorkers);
+    }
+    while(!s_numProcessWorkers.compare_exchange_weak(numProcessWorkers, numProcessWorkers + numReserved));
+
+    return numReserved;
+}
+
+void PhantomRenderPool::pause() noexcept
+{
+   #if JUCE_INTEL
+    _mm_pause();
+   #elif JUCE_ARM && (JUCE_CLANG || JUCE_GCC)
+    __asm__ __volatile__("yield");
+   #endif
+}
+
+PhantomRenderPool::Worker::Worker(PhantomRenderPool& pool, int workerNumber) : Thread("Phantom Render Worker " + String(workerNumber)), m_pool(pool)
+{
+
+}
+
+void PhantomRenderPool::Worker::run()
+{
+    uint32 lastJobTime = Time::getMillisecondCounter();
+
+    while(!threadShouldExit())
+    {
+        const uint32 generation = m_pool.m_generation.load();
+        if(generation == m_generation)
+        {
+            if(Time::getMillisecondCounter() - lastJobTime < (uint32) m_pool.k_spinTimeout)
+            {
+                pause();
+                Thread::yield();
+            }
+            else
+            {
+                wait(m_pool.k_parkPollInterval);
+            }
+
+            continue;
+        }
+
+        m_generation = generation;
+        lastJobTime = Time::getMillisecondCounter();
+
+        m_pool.m_numActiveWorkers.fetch_add(1);
+
+        if(m_pool.m_isJobOpen.load())
+            m_pool.renderClaimedGroups();
+
+        m_pool.m_numActiveWorkers.fetch_sub(1);
+    }
+}
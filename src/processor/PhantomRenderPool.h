@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    PhantomRenderPool.h
+    Created: 17 Oct 2026 13:40:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_RENDER_POOL_H
+#define _PHANTOM_RENDER_POOL_H
+
+#include "JuceHeader.h"
+
+/**
+ * A small pool of pre-spawned, real-time priority worker threads that render the
+ * voice bank groups of a block in parallel with the audio thread.
+ *
+ * The audio thread publishes a job with `render()` and then claims groups itself, so the
+ * block completes even if no worker wakes up in time. Groups are claimed through an atomic
+ * counter and the handoff is a short spin on atomics. Workers keep spinning while blocks
+ * arrive and only park (polling at a low rate) once the host has stopped calling for a while,
+ * so the audio thread never signals them: it never locks or allocates, and never waits on a
+ * worker that isn't rendering.
+ *
+ * The workers of every pool in the process come out of a shared budget of half the physical
+ * cores, so a session with many instances doesn't crowd out the host's own audio threads.
+ */
+class PhantomRenderPool
+{
+public:
+    /**
+     * The interface for the object rendering the groups of a job.
+     */
+    class Job
+    {
+    public:
+        virtual ~Job() = default;
+
+        /**
+         * Renders a single group of the current job.
+         * CAUTION: This method is called from the audio thread and the worker threads concurrently
+         * (for different groups) so it must be real-time safe.
+         * @param group The index of the group to render.
+         */
+        virtual void renderJobGroup(int group) noexcept = 0;
+    };
+
+    /**
+     * @param job The object rendering the groups of a job.
+     * @param numWorkers The number of workers wanted, which is reduced to what is left of the
+     * process-wide budget (possibly none).
+     */
+    PhantomRenderPool(Job& job, int numWorkers);
+    ~PhantomRenderPool();
+
+    /**
+     * Renders every group of a job across the audio thread and the workers, returning once
+     * all of them have been rendered.
+     * @param numGroups The number of groups in the job.
+     */
+    void render(int numGroups) noexcept;
+
+    /**
+     * @returns The number of worker threads (not counting the audio thread).
+     */
+    int getNumWorkers() const noexcept { return m_workers.size(); };
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomRenderPool)
+
+    /**
+     * The worker thread, which polls the pool for new jobs.
+     */
+    class Worker : public Thread
+    {
+    public:
+        Worker(PhantomRenderPool& pool, int workerNumber);
+
+        /**
+         * Spins (or polls slowly once parked) until a job is published and helps render it.
+         * NOTE: A parked worker misses the first block or so of a job stream, which the
+         * audio thread renders on its own, and spins again from the next one.
+         */
+        void run() override;
+
+    private:
+        PhantomRenderPool& m_pool;
+
+        /** The last job generation seen by the worker. */
+        uint32 m_generation = 0;
+    };
+
+    /**
+     * Claims and renders groups of the current job until there are none left.
+     */
+    void renderClaimedGroups() noexcept;
+
+    /**
+     * Takes workers out of the process-wide budget, which the destructor gives back.
+     * @param numWorkers The number of workers wanted.
+     * @returns The number of workers reserved.
+     */
+    static int reserveWorkers(int numWorkers) noexcept;
+
+    /** The object that renders the groups of a job. */
+    Job& m_job;
+
+    /** The worker threads. */
+    OwnedArray<Worker> m_workers;
+
+    /** The job generation, incremented each time a job is published. */
+    std::atomic<uint32> m_generation { 0 };
+
+    /** Whether groups of the current job can still be claimed. */
+    std::atomic<bool> m_isJobOpen { false };
+
+    /** The number of groups in the current job. */
+    std::atomic<int> m_numGroups { 0 };
+
+    /** The index of the next group to claim. */
+    std::atomic<int> m_nextGroup { 0 };
+
+    /** The number of workers currently taking part in a job. */
+    std::atomic<int> m_numActiveWorkers { 0 };
+
+    /** The number of workers of every pool in the process. */
+    static std::atomic<int> s_numProcessWorkers;
+
+    /**
+     * Pauses the CPU for a moment inside a spin loop, which frees its resources for the
+     * sibling hyper-thread and saves power while the loop polls an atomic.
+     */
+    static void pause() noexcept;
+
+    /**
+     * How long a worker spins (yielding) for after a job before it parks (ms), which covers
+     * the wait between blocks at any usual block size and sample rate.
+     */
+    const int k_spinTimeout = 250;
+
+    /**
+     * The number of polls the audio thread pauses for while workers finish their last group,
+     * after which it yields between polls.
+     */
+    const int k_numWaitPolls = 1 << 12;
+
+    /** How long a parked worker sleeps between polls (ms). */
+    const int k_parkPollInterval = 5;
+};
+
+#endif
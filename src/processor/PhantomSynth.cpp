@@ -11,8 +11,9 @@
 #include "PhantomSynth.h"
 #include "PhantomSound.h"
 #include "PhantomVoice.h"
+#include "../utils/PhantomUtils.h"
 
-PhantomSynth::PhantomSynth(AudioProcessorValueTreeState& vts) : m_parameters(vts)
+PhantomSynth::PhantomSynth()
 {
 
 }
@@ -20,36 +21,511 @@ PhantomSynth::PhantomSynth(AudioProcessorValueTreeState& vts) : m_parameters(vts
 PhantomSynth::~PhantomSynth()
 {
     clear();
+
+    m_voiceBank = nullptr;
+    m_voiceAllocator = nullptr;
+    m_smoother = nullptr;
+
+    m_lfo01 = nullptr;
+    m_lfo02 = nullptr;
 }
 
 void PhantomSynth::init(float sampleRate, int samplesPerBlock, int numChannels)
 {
     clear();
 
-    setCurrentPlaybackSampleRate(sampleRate);
+    /** NOTE: Every stage of the voices runs at the oversampled rate. */
+    const float voiceSampleRate = sampleRate * (float) m_oversamplingFactor;
+
+    setCurrentPlaybackSampleRate(voiceSampleRate);
 
     m_processSpec = {
-        (double) sampleRate,
+        (double) voiceSampleRate,
         static_cast<uint32>(samplesPerBlock),
         static_cast<uint32>(1)
     };
 
+    m_voiceBank.reset(new PhantomVoiceBank(k_numVoices, samplesPerBlock));
+    m_voiceAllocator.reset(new PhantomVoiceAllocator(k_numVoices));
+    initSmoother(voiceSampleRate);
+    initGlobalLFOs();
+
+    m_monoBuffer.setSize(1, m_voiceBank->getBlockSize());
+    initOversampling(m_voiceBank->getBlockSize());
+
     addVoices();
     addSounds();
+
+    initRenderPool();
+}
+
+void PhantomSynth::update(const PhantomParameters& parameters) noexcept
+{
+    m_parameters = parameters;
+
+    updateModulationRate();
+    updateOscillatorInterpolation();
 }
 
 void PhantomSynth::clear()
 {
+    m_renderPool = nullptr;
+    m_groupBuffers.clear();
+    m_isGroupRendered.clear();
+
     clearSounds();
     clearVoices();
+
+    m_phantomVoices.clear();
+}
+
+void PhantomSynth::setMultiCoreRendering(bool isEnabled) noexcept
+{
+    m_isMultiCoreRendering = isEnabled;
+}
+
+bool PhantomSynth::isMultiCoreRendering() const noexcept
+{
+    return m_isMultiCoreRendering;
+}
+
+void PhantomSynth::setOversamplingFactor(int factor) noexcept
+{
+    m_oversamplingFactor = jlimit(1, 8, nextPowerOfTwo(factor));
+}
+
+int PhantomSynth::getOversamplingFactor() const noexcept
+{
+    return m_oversamplingFactor;
+}
+
+int PhantomSynth::getLatencyInSamples() const noexcept
+{
+    return m_oversampling != nullptr ? roundToInt(m_oversamplingLatency) : 0;
+}
+
+void PhantomSynth::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    const ScopedLock sl(lock);
+
+    if(m_voiceAllocator == nullptr)
+        return;
+
+    for(int soundIdx = 0; soundIdx < getNumSounds(); soundIdx++)
+    {
+        SynthesiserSound* sound = getSound(soundIdx).get();
+
+        if(!sound->appliesToNote(midiNoteNumber) || !sound->appliesToChannel(midiChannel))
+            continue;
+
+        /** NOTE: Releases the voices still playing the note before it is retriggered. */
+        for(int voiceIdx = m_voiceAllocator->getFirstVoiceForNote(midiNoteNumber); voiceIdx >= 0; voiceIdx = m_voiceAllocator->getNextVoiceForNote(voiceIdx))
+        {
+            PhantomVoice* voice = m_phantomVoices[voiceIdx];
+
+            if(voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel(midiChannel))
+                stopVoice(voice, 1.0f, true);
+        }
+
+        if(PhantomVoice* voice = allocateVoice(midiNoteNumber))
+        {
+            startVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+            voice->setSustainPedalDown(m_sustainPedalsDown[midiChannel]);
+        }
+    }
+}
+
+void PhantomSynth::noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    const ScopedLock sl(lock);
+
+    if(m_voiceAllocator == nullptr)
+        return;
+
+    for(int voiceIdx = m_voiceAllocator->getFirstVoiceForNote(midiNoteNumber); voiceIdx >= 0; voiceIdx = m_voiceAllocator->getNextVoiceForNote(voiceIdx))
+    {
+        PhantomVoice* voice = m_phantomVoices[voiceIdx];
+
+        if(voice->getCurrentlyPlayingNote() != midiNoteNumber || !voice->isPlayingChannel(midiChannel))
+            continue;
+
+        SynthesiserSound* sound = voice->getCurrentlyPlayingSound().get();
+
+        if(sound == nullptr || !sound->appliesToNote(midiNoteNumber) || !sound->appliesToChannel(midiChannel))
+            continue;
+
+        voice->setKeyDown(false);
+
+        if(!voice->isSustainPedalDown() && !voice->isSostenutoPedalDown())
+            stopVoice(voice, velocity, allowTailOff);
+    }
+}
+
+void PhantomSynth::allNotesOff(int midiChannel, bool allowTailOff)
+{
+    const ScopedLock sl(lock);
+
+    if(m_voiceAllocator != nullptr)
+    {
+        /** NOTE: Stopping a voice doesn't free it (that waits for the end of the block), so the list can be walked as it is. */
+        for(int voiceIdx = m_voiceAllocator->getOldestVoice(); voiceIdx >= 0; voiceIdx = m_voiceAllocator->getNextNewerVoice(voiceIdx))
+        {
+            PhantomVoice* voice = m_phantomVoices[voiceIdx];
+
+            if(midiChannel <= 0 || voice->isPlayingChannel(midiChannel))
+                voice->stopNote(1.0f, allowTailOff);
+        }
+    }
+
+    m_sustainPedalsDown.clear();
+}
+
+void PhantomSynth::handleSustainPedal(int midiChannel, bool isDown)
+{
+    jassert(midiChannel > 0 && midiChannel <= 16);
+    const ScopedLock sl(lock);
+
+    if(isDown)
+        m_sustainPedalsDown.setBit(midiChannel);
+
+    if(m_voiceAllocator != nullptr)
+    {
+        for(int voiceIdx = m_voiceAllocator->getOldestVoice(); voiceIdx >= 0; voiceIdx = m_voiceAllocator->getNextNewerVoice(voiceIdx))
+        {
+            PhantomVoice* voice = m_phantomVoices[voiceIdx];
+
+            if(!voice->isPlayingChannel(midiChannel))
+                continue;
+
+            if(isDown)
+            {
+                if(voice->isKeyDown())
+                    voice->setSustainPedalDown(true);
+            }
+            else
+            {
+                voice->setSustainPedalDown(false);
+
+                if(!voice->isKeyDown() && !voice->isSostenutoPedalDown())
+                    stopVoice(voice, 1.0f, true);
+            }
+        }
+    }
+
+    if(!isDown)
+        m_sustainPedalsDown.clearBit(midiChannel);
+}
+
+PhantomVoice* PhantomSynth::allocateVoice(int midiNoteNumber) noexcept
+{
+    int stolenVoiceIdx = -1;
+
+    if(m_voiceAllocator->getNumPlaying() >= (int) m_parameters.polyphony)
+    {
+        if(!isNoteStealingEnabled())
+            return nullptr;
+
+        stolenVoiceIdx = findVoiceIndexToSteal();
+        if(stolenVoiceIdx >= 0)
+        {
+            m_phantomVoices[stolenVoiceIdx]->fadeOut();
+            m_voiceAllocator->steal(stolenVoiceIdx);
+        }
+    }
+
+    int voiceIdx = m_voiceAllocator->allocate(midiNoteNumber);
+
+    /**
+     * NOTE: Every lane is taken by playing or fading voices, so a voice is cut off instead
+     * (preferably the one just stolen, which is the quietest choice).
+     */
+    if(voiceIdx < 0)
+    {
+        if(stolenVoiceIdx < 0)
+            stolenVoiceIdx = m_voiceAllocator->getOldestVoice();
+
+        if(stolenVoiceIdx < 0)
+            return nullptr;
+
+        m_voiceAllocator->release(stolenVoiceIdx);
+        voiceIdx = m_voiceAllocator->allocate(midiNoteNumber);
+    }
+
+    return voiceIdx >= 0 ? m_phantomVoices[voiceIdx] : nullptr;
+}
+
+int PhantomSynth::findVoiceIndexToSteal() const noexcept
+{
+    const auto stealMode = (PhantomVoiceAllocator::StealMode) (int) m_parameters.voiceSteal;
+
+    int oldestVoiceIdx = -1;
+    int quietestVoiceIdx = -1;
+    float quietestLevel = std::numeric_limits<float>::max();
+
+    for(int voiceIdx = m_voiceAllocator->getOldestVoice(); voiceIdx >= 0; voiceIdx = m_voiceAllocator->getNextNewerVoice(voiceIdx))
+    {
+        if(m_voiceAllocator->getState(voiceIdx) != PhantomVoiceAllocator::PLAYING)
+            continue;
+
+        if(oldestVoiceIdx < 0)
+        {
+            oldestVoiceIdx = voiceIdx;
+
+            if(stealMode == PhantomVoiceAllocator::OLDEST)
+                break;
+        }
+
+        if(stealMode == PhantomVoiceAllocator::RELEASED)
+        {
+            PhantomVoice* voice = m_phantomVoices[voiceIdx];
+
+            if(!voice->isKeyDown() && !voice->isSustainPedalDown() && !voice->isSostenutoPedalDown())
+                return voiceIdx;
+        }
+        else if(stealMode == PhantomVoiceAllocator::QUIETEST)
+        {
+            const float level = m_voiceBank->getAmpLevel(voiceIdx);
+
+            if(level < quietestLevel)
+            {
+                quietestLevel = level;
+                quietestVoiceIdx = voiceIdx;
+            }
+        }
+    }
+
+    return quietestVoiceIdx >= 0 ? quietestVoiceIdx : oldestVoiceIdx;
+}
+
+void PhantomSynth::stealVoicesAbovePolyphony() noexcept
+{
+    const int polyphony = (int) m_parameters.polyphony;
+
+    while(m_voiceAllocator->getNumPlaying() > polyphony)
+    {
+        const int voiceIdx = findVoiceIndexToSteal();
+
+        if(voiceIdx < 0)
+            break;
+
+        m_phantomVoices[voiceIdx]->fadeOut();
+        m_voiceAllocator->steal(voiceIdx);
+    }
+}
+
+void PhantomSynth::releaseFinishedVoices() noexcept
+{
+    int voiceIdx = m_voiceAllocator->getOldestVoice();
+
+    while(voiceIdx >= 0)
+    {
+        const int nextVoiceIdx = m_voiceAllocator->getNextNewerVoice(voiceIdx);
+
+        if(!m_phantomVoices[voiceIdx]->isRendering())
+            m_voiceAllocator->release(voiceIdx);
+
+        voiceIdx = nextVoiceIdx;
+    }
+}
+
+void PhantomSynth::initSmoother(float sampleRate)
+{
+    const float rampTime = Consts::_PARAM_SMOOTHING_TIME;
+
+    m_smoother.reset(new PhantomSmoother());
+
+    for(int osc = 0; osc < 2; osc++)
+    {
+        m_smoother->add(m_parameters.osc[osc].shapeInt, m_ramps.osc[osc].shapeInt, rampTime, PhantomSmoother::LINEAR);
+        m_smoother->add(m_parameters.osc[osc].modDepth, m_ramps.osc[osc].modDepth, rampTime, PhantomSmoother::LINEAR);
+        m_smoother->add(m_parameters.osc[osc].phasor.egInt, m_ramps.osc[osc].phasor.egInt, rampTime, PhantomSmoother::LINEAR);
+        m_smoother->add(m_parameters.osc[osc].phasor.lfoInt, m_ramps.osc[osc].phasor.lfoInt, rampTime, PhantomSmoother::LINEAR);
+    }
+
+    m_smoother->add(m_parameters.mixer.oscBalance, m_ramps.mixer.oscBalance, rampTime, PhantomSmoother::LINEAR);
+    m_smoother->add(m_parameters.mixer.ampGain, m_ramps.mixer.ampGain, rampTime, PhantomSmoother::MULTIPLICATIVE);
+    m_smoother->add(m_parameters.mixer.ringMod, m_ramps.mixer.ringMod, rampTime, PhantomSmoother::LINEAR);
+    m_smoother->add(m_parameters.mixer.noise, m_ramps.mixer.noise, rampTime, PhantomSmoother::LINEAR);
+
+    m_smoother->add(m_parameters.filter.cutoff, m_ramps.filter.cutoff, rampTime, PhantomSmoother::MULTIPLICATIVE);
+    m_smoother->add(m_parameters.filter.resonance, m_ramps.filter.resonance, rampTime, PhantomSmoother::MULTIPLICATIVE);
+    m_smoother->add(m_parameters.filter.drive, m_ramps.filter.drive, rampTime, PhantomSmoother::LINEAR);
+    m_smoother->add(m_parameters.filter.egModDepth, m_ramps.filter.egModDepth, rampTime, PhantomSmoother::LINEAR);
+    m_smoother->add(m_parameters.filter.lfoModDepth, m_ramps.filter.lfoModDepth, rampTime, PhantomSmoother::LINEAR);
+
+    /** NOTE: The sustain levels are in decibels, so a linear ramp is already exponential in gain. */
+    for(int eg = 0; eg < 4; eg++)
+        m_smoother->add(m_parameters.eg[eg].sustain, m_ramps.egSustain[eg], rampTime, PhantomSmoother::LINEAR);
+
+    m_smoother->prepare(sampleRate, m_voiceBank->getBlockSize());
+}
+
+void PhantomSynth::updateModulationRate() noexcept
+{
+    const int modRate = jlimit(0, 3, (int) m_parameters.modRate);
+    const int interval = modRate == 0 ? 1 : 4 << modRate;
+    const bool isAmpEnvAudioRate = m_parameters.ampEgAudioRate != 0.0f;
+
+    if(interval == m_modControlInterval && isAmpEnvAudioRate == m_isAmpEnvAudioRate)
+        return;
+
+    m_modControlInterval = interval;
+    m_isAmpEnvAudioRate = isAmpEnvAudioRate;
+
+    if(m_lfo01 != nullptr)
+    {
+        m_lfo01->setControlInterval(m_modControlInterval * m_oversamplingFactor);
+        m_lfo02->setControlInterval(m_modControlInterval * m_oversamplingFactor);
+    }
+
+    for(auto* voice : m_phantomVoices)
+        voice->setModulationControlInterval(m_modControlInterval * m_oversamplingFactor, m_isAmpEnvAudioRate);
+}
+
+void PhantomSynth::updateOscillatorInterpolation() noexcept
+{
+    const auto interpolation = (int) m_parameters.oscInterpolation == PhantomWavetable::LINEAR ? PhantomWavetable::LINEAR : PhantomWavetable::CUBIC;
+
+    if(interpolation == m_oscInterpolation)
+        return;
+
+    m_oscInterpolation = interpolation;
+
+    for(auto* voice : m_phantomVoices)
+        voice->setOscillatorInterpolation(m_oscInterpolation);
+}
+
+void PhantomSynth::initGlobalLFOs()
+{
+    m_lfo01.reset(new PhantomLFO());
+    m_lfo02.reset(new PhantomLFO());
+
+    /** NOTE: The global LFOs run at the same control rate as the voices' own LFOs. */
+    m_lfo01->setControlInterval(m_modControlInterval * m_oversamplingFactor);
+    m_lfo02->setControlInterval(m_modControlInterval * m_oversamplingFactor);
+
+    m_lfoBuffer.setSize(2, m_voiceBank->getBlockSize());
+    m_lfoBuffer.clear();
+
+    m_globalModulation.lfo[0] = m_lfoBuffer.getReadPointer(0);
+    m_globalModulation.lfo[1] = m_lfoBuffer.getReadPointer(1);
+}
+
+void PhantomSynth::renderGlobalLFOs(int numSamples) noexcept
+{
+    if((int) m_parameters.lfo[0].mode == PhantomLFO::GLOBAL)
+        m_lfo01->evaluate(m_lfoBuffer.getWritePointer(0), numSamples);
+
+    if((int) m_parameters.lfo[1].mode == PhantomLFO::GLOBAL)
+        m_lfo02->evaluate(m_lfoBuffer.getWritePointer(1), numSamples);
+}
+
+void PhantomSynth::initOversampling(int samplesPerBlock)
+{
+    m_oversampling = nullptr;
+    m_oversampledMix = {};
+    m_oversamplingLatency = 0.0f;
+
+    if(m_oversamplingFactor <= 1)
+        return;
+
+    const size_t numStages = (size_t) findHighestSetBit((uint32) m_oversamplingFactor);
+
+    m_oversampling.reset(new dsp::Oversampling<float>(1, numStages, dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, false));
+    m_oversampling->initProcessing((size_t) samplesPerBlock);
+
+    /**
+     * NOTE: The up-sampling filters are run once (on silence) only to get the buffer of the last
+     * stage, which `processSamplesDown()` decimates from. That buffer stays put until the next
+     * `initProcessing()`, so the voices are rendered straight into it and only the down-sampling 
+     * filters run per block.
+     * CAUTION: This relies on JUCE internals: `processSamplesUp()` returning the last stage's own
+     * buffer, and `processSamplesDown()` reading from that same buffer.
+     */
+    m_monoBuffer.clear();
+
+    dsp::AudioBlock<const float> silence(m_monoBuffer.getArrayOfReadPointers(), 1, (size_t) samplesPerBlock);
+    m_oversampledMix = m_oversampling->processSamplesUp(silence);
+
+    m_oversamplingLatency = measureDownsamplingLatency(samplesPerBlock);
+
+    m_oversampling->reset();
+}
+
+float PhantomSynth::measureDownsamplingLatency(int samplesPerBlock)
+{
+    /**
+     * NOTE: `dsp::Oversampling::getLatencyInSamples()` adds the group delay of the up-sampling
+     * filters, which never run on the voices, so the latency of the decimation alone is
+     * measured instead: the group delay (at DC) of its impulse response, sum(n * h[n]) / sum(h[n]).
+     */
+    m_oversampling->reset();
+
+    dsp::AudioBlock<float> response(m_monoBuffer.getArrayOfWritePointers(), 1, (size_t) samplesPerBlock);
+
+    double sum = 0.0;
+    double weightedSum = 0.0;
+
+    for(int start = 0; start < k_latencyResponseLength; start += samplesPerBlock)
+    {
+        m_oversampledMix.clear();
+
+        if(start == 0)
+            m_oversampledMix.setSample(0, 0, 1.0f);
+
+        m_oversampling->processSamplesDown(response);
+
+        for(int i = 0; i < samplesPerBlock; i++)
+        {
+            const double sample = (double) response.getSample(0, i);
+
+            sum += sample;
+            weightedSum += sample * (double) (start + i);
+        }
+    }
+
+    m_oversampledMix.clear();
+    m_monoBuffer.clear();
+
+    return sum != 0.0 ? (float) (weightedSum / sum) : 0.0f;
+}
+
+void PhantomSynth::initRenderPool()
+{
+    if(!m_isMultiCoreRendering)
+        return;
+
+    const int numGroups = m_voiceBank->getNumGroups();
+    const int numWorkers = jmin(k_maxNumWorkers, numGroups - 1);
+
+    if(numWorkers <= 0)
+        return;
+
+    m_renderPool.reset(new PhantomRenderPool(*this, numWorkers));
+
+    if(m_renderPool->getNumWorkers() == 0)
+    {
+        m_renderPool.reset();
+        return;
+    }
+
+    for(int group = 0; group < numGroups; group++)
+    {
+        m_groupBuffers.add(new AudioBuffer<float>(1, m_voiceBank->getBlockSize()));
+        m_isGroupRendered.add(false);
+    }
 }
 
 void PhantomSynth::addVoices()
 {
     for(int i = 0; i < k_numVoices; i++)
     {
-        PhantomVoice* voice = new PhantomVoice(m_parameters, m_processSpec);
+        PhantomVoice* voice = new PhantomVoice(m_parameters, m_ramps, m_globalModulation, m_processSpec, *m_voiceBank, i);
+        voice->setModulationControlInterval(m_modControlInterval * m_oversamplingFactor, m_isAmpEnvAudioRate);
+        voice->setOscillatorInterpolation(m_oscInterpolation);
         addVoice(voice);
+
+        m_phantomVoices.add(voice);
     }
 }
 
@@ -58,3 +534,166 @@ void PhantomSynth::addSounds()
     PhantomSound* sound = new PhantomSound();
     addSound(sound);
 }
+
+void PhantomSynth::renderVoices(AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    /** NOTE: The polyphony is only checked when a note starts, so the voices above it after it is lowered are stolen here. */
+    stealVoicesAbovePolyphony();
+
+    for(auto* voice : m_phantomVoices)
+        if(voice->isRendering())
+            voice->update();
+
+    m_lfo01->update(m_parameters.lfo[0], (float) getSampleRate());
+    m_lfo02->update(m_parameters.lfo[1], (float) getSampleRate());
+
+    float* monoMix = m_monoBuffer.getWritePointer(0);
+
+    while(numSamples > 0)
+    {
+        const int numToRender = jmin(numSamples, m_monoBuffer.getNumSamples());
+        bool isRendered = false;
+
+        if(m_oversampling != nullptr)
+        {
+            /** 
+             * NOTE: The voices overwrite the up-sampled mix, which is then decimated back into 
+             * the mono mix. The decimation runs even when no voice is rendering, so the filters 
+             * ring out instead of holding the last samples.
+             */
+            renderMix(m_oversampledMix.getChannelPointer(0), numToRender * m_oversamplingFactor);
+
+            dsp::AudioBlock<float> mix(m_monoBuffer.getArrayOfWritePointers(), 1, (size_t) numToRender);
+            m_oversampling->processSamplesDown(mix);
+
+            isRendered = true;
+        }
+        else
+        {
+            isRendered = renderMix(monoMix, numToRender);
+        }
+
+        if(isRendered)
+            for(int channel = 0; channel < buffer.getNumChannels(); channel++)
+                buffer.addFrom(channel, startSample, monoMix, numToRender);
+
+        startSample += numToRender;
+        numSamples -= numToRender;
+    }
+
+    releaseFinishedVoices();
+}
+
+bool PhantomSynth::renderMix(float* dest, int numSamples) noexcept
+{
+    bool isRendered = false;
+
+    while(numSamples > 0)
+    {
+        const int numToRender = jmin(numSamples, m_voiceBank->getBlockSize());
+
+        m_smoother->process(numToRender);
+        renderGlobalLFOs(numToRender);
+
+        FloatVectorOperations::clear(dest, numToRender);
+
+        if(shouldRenderInParallel(numToRender))
+        {
+            isRendered |= renderGroupsInParallel(dest, numToRender);
+        }
+        else
+        {
+            for(int group = 0; group < m_voiceBank->getNumGroups(); group++)
+            {
+                if(isGroupRendering(group))
+                {
+                    renderGroup(group, dest, numToRender);
+                    isRendered = true;
+                }
+            }
+        }
+
+        dest += numToRender;
+        numSamples -= numToRender;
+    }
+
+    return isRendered;
+}
+
+bool PhantomSynth::shouldRenderInParallel(int numSamples) const noexcept
+{
+    if(m_renderPool == nullptr)
+        return false;
+
+    /** NOTE: A single group is always rendered on the audio thread (whatever the block size), so the workers stay parked. */
+    int numRenderingGroups = 0;
+    for(int group = 0; group < m_voiceBank->getNumGroups() && numRenderingGroups < 2; group++)
+        if(isGroupRendering(group))
+            numRenderingGroups++;
+
+    return numRenderingGroups > 1 && numSamples >= k_minParallelBlockSize;
+}
+
+bool PhantomSynth::renderGroupsInParallel(float* dest, int numSamples) noexcept
+{
+    m_jobNumSamples = numSamples;
+    m_renderPool->render(m_voiceBank->getNumGroups());
+
+    bool isRendered = false;
+
+    for(int group = 0; group < m_voiceBank->getNumGroups(); group++)
+    {
+        if(!m_isGroupRendered[group])
+            continue;
+
+        FloatVectorOperations::add(dest, m_groupBuffers.getUnchecked(group)->getReadPointer(0), numSamples);
+        isRendered = true;
+    }
+
+    return isRendered;
+}
+
+void PhantomSynth::renderJobGroup(int group) noexcept
+{
+    const bool isRendering = isGroupRendering(group);
+    m_isGroupRendered.set(group, isRendering);
+
+    if(!isRendering)
+        return;
+
+    float* groupMix = m_groupBuffers.getUnchecked(group)->getWritePointer(0);
+    FloatVectorOperations::clear(groupMix, m_jobNumSamples);
+
+    renderGroup(group, groupMix, m_jobNumSamples);
+}
+
+bool PhantomSynth::isGroupRendering(int group) const noexcept
+{
+    const int firstVoice = group * PhantomVoiceBank::k_laneWidth;
+    const int lastVoice = jmin(firstVoice + PhantomVoiceBank::k_laneWidth, m_phantomVoices.size());
+
+    for(int i = firstVoice; i < lastVoice; i++)
+        if(m_phantomVoices[i]->isRendering())
+            return true;
+
+    return false;
+}
+
+void PhantomSynth::renderGroup(int group, float* dest, int numSamples) noexcept
+{
+    const int firstVoice = group * PhantomVoiceBank::k_laneWidth;
+    const int lastVoice = jmin(firstVoice + PhantomVoiceBank::k_laneWidth, m_phantomVoices.size());
+
+    for(int i = firstVoice; i < lastVoice; i++)
+        m_phantomVoices[i]->renderModulation(numSamples);
+
+    m_voiceBank->advancePhases(group, m_parameters.oscSync != 0.0f, numSamples);
+
+    for(int i = firstVoice; i < lastVoice; i++)
+        m_phantomVoices[i]->renderOscillators(numSamples);
+
+    m_voiceBank->filter(group, numSamples);
+
+    for(int i = firstVoice; i < lastVoice; i++)
+        m_phantomVoices[i]->renderOutput(dest, numSamples);
+}
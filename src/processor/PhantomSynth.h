@@ -13,13 +13,24 @@
 
 #include "JuceHeader.h"
 
+#include "PhantomRenderPool.h"
+#include "PhantomVoiceAllocator.h"
+#include "PhantomVoiceBank.h"
+#include "../generators/PhantomLFO.h"
+#include "../generators/PhantomWavetableStore.h"
+#include "../utils/PhantomParameters.h"
+#include "../utils/PhantomSmoother.h"
+#include "../utils/PhantomUtils.h"
+
+class PhantomVoice;
+
 /**
  * The synthesizer class for Phantom.
  */
-class PhantomSynth : public Synthesiser
+class PhantomSynth : public Synthesiser, private PhantomRenderPool::Job
 {
 public:
-    PhantomSynth(AudioProcessorValueTreeState&);
+    PhantomSynth();
     ~PhantomSynth() override;
 
     /**
@@ -30,14 +41,210 @@ public:
      */
     void init(float sampleRate, int samplesPerBlock, int numChannels);
 
+    /**
+     * Takes a copy of the parameter snapshot for the next block, which every voice reads from,
+     * and applies the engine settings that don't need a new `init()` (the modulation rate, amp
+     * EG audio rate and oscillator interpolation) to the voices.
+     * CAUTION: This must be called from the audio thread before `renderNextBlock()`.
+     * @param parameters The parameter values for the block.
+     */
+    void update(const PhantomParameters& parameters) noexcept;
+
     /**
      * Clears sounds and voices from the synthesizer.
      */
     void clear();
 
+    /**
+     * Turns multi-core rendering ON or OFF, which takes effect on the next call to `init()`.
+     * NOTE: With multi-core rendering ON, the voice bank groups of a block are split between 
+     * the audio thread and a pool of worker threads.
+     * @param isEnabled Whether multi-core rendering is ON.
+     */
+    void setMultiCoreRendering(bool isEnabled) noexcept;
+
+    /**
+     * @returns Whether multi-core rendering is ON (as of the next call to `init()`).
+     */
+    bool isMultiCoreRendering() const noexcept;
+
+    /**
+     * Sets the factor the voices are oversampled by, which takes effect on the next call to `init()`.
+     * NOTE: The voices are rendered at the oversampled rate into a single mono mix, which is 
+     * decimated once with polyphase IIR half-band filters, so the filters are shared by every voice.
+     * @param factor The oversampling factor (1, 2, 4 or 8).
+     */
+    void setOversamplingFactor(int factor) noexcept;
+
+    /**
+     * @returns The factor the voices are oversampled by (as of the next call to `init()`).
+     */
+    int getOversamplingFactor() const noexcept;
+
+    /**
+     * @returns The latency (in samples at the base rate) added by the oversampling filters.
+     */
+    int getLatencyInSamples() const noexcept;
+
+    /**
+     * Starts a note on a free voice (stealing one if the polyphony is reached), replacing 
+     * the linear voice scan of the `Synthesiser`.
+     * @param midiChannel The MIDI channel of the note.
+     * @param midiNoteNumber The pitch value from the note MIDI data.
+     * @param velocity The velocity value from the note MIDI data.
+     */
+    void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+
+    /**
+     * Releases the voices playing a note (unless a pedal holds them), looking them up by note
+     * instead of scanning every voice.
+     * @param midiChannel The MIDI channel of the note.
+     * @param midiNoteNumber The pitch value from the note MIDI data.
+     * @param velocity The release velocity from the note MIDI data.
+     * @param allowTailOff Whether the voices release through their envelopes (or stop at once).
+     */
+    void noteOff(int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+
+    /**
+     * Stops every voice in use on a channel, visiting only the voices in use.
+     * @param midiChannel The MIDI channel (or 0 for every channel).
+     * @param allowTailOff Whether the voices release through their envelopes (or stop at once).
+     */
+    void allNotesOff(int midiChannel, bool allowTailOff) override;
+
+    /**
+     * Holds or releases the voices of a channel with the sustain pedal, visiting only the voices in use.
+     * @param midiChannel The MIDI channel of the pedal.
+     * @param isDown Whether the pedal is pressed.
+     */
+    void handleSustainPedal(int midiChannel, bool isDown) override;
+
+protected:
+    /**
+     * Renders the voices through the voice bank, one SIMD group of voices at a time.
+     * @param buffer The audio buffer to add the voices to.
+     * @param startSample The sample index to begin with.
+     * @param numSamples The number of samples to render.
+     */
+    void renderVoices(AudioBuffer<float>& buffer, int startSample, int numSamples) override;
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomSynth)
 
+    /**
+     * Renders every voice bank group into a mono mix, one bank block at a time.
+     * @param dest The mono mix to write the voices to, which is cleared first.
+     * @param numSamples The number of samples to render.
+     * @returns `true` if any group was rendered.
+     */
+    bool renderMix(float* dest, int numSamples) noexcept;
+
+    /**
+     * @param group The voice bank group to check.
+     * @returns `true` if any voice of the group is rendering.
+     */
+    bool isGroupRendering(int group) const noexcept;
+
+    /**
+     * Runs every stage of the voices in a single voice bank group.
+     * @param group The voice bank group to render.
+     * @param dest The mono mix to add the voices to.
+     * @param numSamples The number of samples to render (no more than the bank's block size).
+     */
+    void renderGroup(int group, float* dest, int numSamples) noexcept;
+
+    /**
+     * Renders a voice bank group into its own group buffer, called by the render pool.
+     * @param group The voice bank group to render.
+     */
+    void renderJobGroup(int group) noexcept override;
+
+    /**
+     * Renders every voice bank group across the render pool and adds the group buffers
+     * to the mono mix in group order, so the result doesn't depend on thread timing.
+     * @param dest The mono mix to add the voices to.
+     * @param numSamples The number of samples to render (no more than the bank's block size).
+     * @returns `true` if any group was rendered.
+     */
+    bool renderGroupsInParallel(float* dest, int numSamples) noexcept;
+
+    /**
+     * @param numSamples The number of samples to render.
+     * @returns `true` if the block is worth splitting across the render pool.
+     */
+    bool shouldRenderInParallel(int numSamples) const noexcept;
+
+    /**
+     * Creates the render pool and group buffers when multi-core rendering is ON.
+     */
+    void initRenderPool();
+
+    /**
+     * Creates the oversampling filters when the oversampling factor is above 1.
+     * @param samplesPerBlock The largest number of samples (at the base rate) rendered at once.
+     */
+    void initOversampling(int samplesPerBlock);
+
+    /**
+     * Runs an impulse through the down-sampling filters, which are reset before and after.
+     * @param samplesPerBlock The number of samples (at the base rate) decimated at once.
+     * @returns The group delay of the down-sampling filters (in samples at the base rate).
+     */
+    float measureDownsamplingLatency(int samplesPerBlock);
+
+    /**
+     * Creates the smoother for the continuous parameters of the voices, with the ramp time
+     * and curve of each parameter.
+     * @param sampleRate The sample rate to use in smoothing the parameters.
+     */
+    void initSmoother(float sampleRate);
+
+    /**
+     * Applies the modulation rate and amp EG audio rate of the parameters to the global LFOs and
+     * the voices if either changed, with the next modulation values computed on the next sample.
+     */
+    void updateModulationRate() noexcept;
+
+    /**
+     * Applies the oscillator interpolation mode of the parameters to the voices if it changed.
+     */
+    void updateOscillatorInterpolation() noexcept;
+
+    /**
+     * Creates the global LFOs and the buffer holding their values.
+     */
+    void initGlobalLFOs();
+
+    /**
+     * Computes the next values of the LFOs in global mode, once for every voice.
+     * @param numSamples The number of samples to compute (no more than the bank's block size).
+     */
+    void renderGlobalLFOs(int numSamples) noexcept;
+
+    /**
+     * Takes a voice from the allocator for a new note, stealing a voice with the current
+     * voice steal mode when the polyphony is reached.
+     * @param midiNoteNumber The MIDI note to allocate a voice for.
+     * @returns The voice to start the note on, or `nullptr` if no voice can be used.
+     */
+    PhantomVoice* allocateVoice(int midiNoteNumber) noexcept;
+
+    /**
+     * @returns The index of the playing voice to steal with the current voice steal mode, or -1 if no voice is playing.
+     */
+    int findVoiceIndexToSteal() const noexcept;
+
+    /**
+     * Returns the voices that have finished rendering to the allocator's free stack.
+     */
+    void releaseFinishedVoices() noexcept;
+
+    /**
+     * Fades out the voices playing above the polyphony (after it was lowered), choosing them
+     * with the current voice steal mode.
+     */
+    void stealVoicesAbovePolyphony() noexcept;
+
     /**
      * Adds voices to the synthesizer object.
      */
@@ -54,12 +261,157 @@ private:
      */
     dsp::ProcessSpec m_processSpec;
   
-    AudioProcessorValueTreeState& m_parameters;
+    /**
+     * The parameter values for the current block, shared (read-only) by every voice.
+     */
+    PhantomParameters m_parameters;
+
+    /**
+     * The smoothed parameters for the samples being rendered, shared (read-only) by every voice.
+     */
+    PhantomRamps m_ramps;
+
+    /**
+     * The smoother writing `m_ramps` from the parameter snapshot.
+     */
+    std::unique_ptr<PhantomSmoother> m_smoother;
+
+    /**
+     * The unique pointer for the first global LFO.
+     */
+    std::unique_ptr<PhantomLFO> m_lfo01;
+
+    /**
+     * The unique pointer for the second global LFO.
+     */
+    std::unique_ptr<PhantomLFO> m_lfo02;
+
+    /**
+     * The values of the global LFOs for the samples being rendered, one channel per LFO.
+     */
+    AudioBuffer<float> m_lfoBuffer;
+
+    /**
+     * The global LFO values for the samples being rendered, shared (read-only) by every voice.
+     */
+    PhantomGlobalModulation m_globalModulation;
+
+    /**
+     * The shared wavetables, held for the lifetime of the synth so they aren't rebuilt 
+     * every time the voices are recreated.
+     */
+    SharedResourcePointer<PhantomWavetableStore> m_wavetables;
+
+    /**
+     * The voice bank holding the structure-of-arrays state of every voice.
+     */
+    std::unique_ptr<PhantomVoiceBank> m_voiceBank;
+
+    /**
+     * The voices of the synth (owned by the `Synthesiser`), indexed by their voice bank lane.
+     */
+    Array<PhantomVoice*> m_phantomVoices;
+
+    /**
+     * The allocator tracking the free and playing voices.
+     */
+    std::unique_ptr<PhantomVoiceAllocator> m_voiceAllocator;
+
+    /**
+     * The MIDI channels with the sustain pedal down.
+     * NOTE: The `Synthesiser` keeps its own copy private, which only its (replaced) pedal handler updates.
+     */
+    BigInteger m_sustainPedalsDown;
+
+    /**
+     * The pool of worker threads for multi-core rendering (`nullptr` when rendering serially).
+     */
+    std::unique_ptr<PhantomRenderPool> m_renderPool;
+
+    /**
+     * The mono mix of every voice, which is added to each output channel once per block.
+     * NOTE: The voice output is mono, so voices never write to the output channels themselves.
+     */
+    AudioBuffer<float> m_monoBuffer;
+
+    /**
+     * The oversampling filters of the mono mix (`nullptr` when the voices aren't oversampled).
+     */
+    std::unique_ptr<dsp::Oversampling<float>> m_oversampling;
+
+    /**
+     * The up-sampled buffer of the oversampling filters, which the voices are rendered into.
+     */
+    dsp::AudioBlock<float> m_oversampledMix;
+
+    /**
+     * The latency (in samples at the base rate) of the down-sampling filters.
+     */
+    float m_oversamplingLatency = 0.0f;
+
+    /**
+     * The mono buffers each voice bank group is rendered into with multi-core rendering.
+     */
+    OwnedArray<AudioBuffer<float>> m_groupBuffers;
+
+    /**
+     * Whether each group buffer was written to by the current job.
+     */
+    Array<bool> m_isGroupRendered;
+
+    /**
+     * The number of samples rendered by the current job of the render pool.
+     */
+    int m_jobNumSamples = 0;
+
+    /**
+     * Boolean value for if multi-core rendering is turned on (true) or off (false).
+     */
+    bool m_isMultiCoreRendering = false;
+
+    /**
+     * The number of samples between the computed modulation values of the voices (at the base rate).
+     */
+    int m_modControlInterval = Consts::_MOD_CONTROL_INTERVAL;
+
+    /**
+     * Boolean value for if the amplifier envelope is computed every sample (true) or at control rate (false).
+     */
+    bool m_isAmpEnvAudioRate = true;
+
+    /**
+     * The interpolation mode of the oscillators' wavetable reads.
+     */
+    PhantomWavetable::Interpolation m_oscInterpolation = PhantomWavetable::CUBIC;
+
+    /**
+     * The factor the voices are oversampled by.
+     */
+    int m_oversamplingFactor = 1;
+
+    /**
+     * The number of voices to use in the synth, which leaves a group of voices on top of the
+     * maximum polyphony for stolen voices to fade out on.
+     */
+    const int k_numVoices = Consts::_MAX_POLYPHONY + PhantomVoiceBank::k_laneWidth;
+
+    /**
+     * The number of samples (at the base rate) of the impulse response the oversampling
+     * latency is measured over, by which point the decimation filters have rung out.
+     */
+    const int k_latencyResponseLength = 512;
+
+    /**
+     * The maximum number of worker threads in the render pool of an instance, which the
+     * pool further limits to what is left of its process-wide budget.
+     */
+    const int k_maxNumWorkers = 3;
 
     /**
-     * The number of voices to use in the synth.
+     * The smallest block that is split across the render pool, below which the handoff 
+     * costs more than it saves.
      */
-    const int k_numVoices = 4;
+    const int k_minParallelBlockSize = 32;
 };
 
 #endif
@@ -13,29 +13,28 @@
 #include "PhantomSound.h"
 #include "../utils/PhantomUtils.h"
 
-PhantomVoice::PhantomVoice(AudioProcessorValueTreeState& vts, dsp::ProcessSpec& ps) : m_parameters(vts)
+PhantomVoice::PhantomVoice(const PhantomParameters& parameters, const PhantomRamps& ramps, const PhantomGlobalModulation& globalModulation, dsp::ProcessSpec& ps, PhantomVoiceBank& bank, int lane) : m_parameters(parameters), m_globalModulation(globalModulation), m_bank(bank), m_lane(lane)
 {
-    p_oscSync = m_parameters.getRawParameterValue(Consts::_OSC_SYNC_PARAM_ID);
-    
-    m_ampEnv.reset(new PhantomEnvelope(m_parameters, EnvelopeType::AMP));
-    m_phaseEnv.reset(new PhantomEnvelope(m_parameters, EnvelopeType::PHASOR));
-    m_filterEnv.reset(new PhantomEnvelope(m_parameters, EnvelopeType::FILTER));
-    m_modEnv.reset(new PhantomEnvelope(m_parameters, EnvelopeType::MOD));
+    m_ampEnv.reset(new PhantomEnvelope(ramps.egSustain[EnvelopeType::AMP]));
+    m_phaseEnv.reset(new PhantomEnvelope(ramps.egSustain[EnvelopeType::PHASOR]));
+    m_filterEnv.reset(new PhantomEnvelope(ramps.egSustain[EnvelopeType::FILTER]));
+    m_modEnv.reset(new PhantomEnvelope(ramps.egSustain[EnvelopeType::MOD]));
+
+    m_lfo01.reset(new PhantomLFO());
+    m_lfo02.reset(new PhantomLFO());
 
-    m_lfo01.reset(new PhantomLFO(m_parameters, 1));
-    m_lfo02.reset(new PhantomLFO(m_parameters, 2));
+    m_primaryOsc.reset(new PhantomOscillator(ramps.osc[0]));
+    m_secondaryOsc.reset(new PhantomOscillator(ramps.osc[1]));
+    m_mixer.reset(new PhantomMixer(ramps.mixer));
 
-    m_primaryOsc.reset(new PhantomOscillator(m_parameters, 1));
-    m_secondaryOsc.reset(new PhantomOscillator(m_parameters, 2));
-    m_mixer.reset(new PhantomMixer(m_parameters));
+    m_filter.reset(new PhantomFilter(ps, ramps.filter));
 
-    m_filter.reset(new PhantomFilter(m_parameters, ps));
+    m_blockSize = m_bank.getBlockSize();
+    m_scratchBuffer.setSize(NUM_SCRATCH_CHANNELS, m_blockSize);
 }
 
 PhantomVoice::~PhantomVoice()
 {
-    p_oscSync = nullptr;
-
     m_ampEnv = nullptr;
     m_phaseEnv = nullptr;
     m_filterEnv = nullptr;
@@ -62,11 +61,14 @@ void PhantomVoice::startNote(int midiNoteNumber, float velocity, SynthesiserSoun
     m_isNoteOn = true;
     m_isNoteCleared = false;
 
+    m_isFadingOut = false;
+    m_tailOff = 1.0f;
+
     const float sampleRate = (float) getSampleRate();
 
     m_midiNoteNumber = midiNoteNumber;
-    m_primaryOsc->update(m_midiNoteNumber, sampleRate);
-    m_secondaryOsc->update(m_midiNoteNumber, sampleRate);
+    m_primaryOsc->update(m_parameters.osc[0], m_midiNoteNumber, sampleRate);
+    m_secondaryOsc->update(m_parameters.osc[1], m_midiNoteNumber, sampleRate);
 
     m_ampEnv->noteOn();
     m_phaseEnv->noteOn();
@@ -101,67 +103,213 @@ void PhantomVoice::clear()
 
     m_primaryOsc->reset();
     m_secondaryOsc->reset();
+    m_filter->reset();
 
+    m_bank.resetLane(m_lane);
+
+    m_isNoteOn = false;
     m_isNoteCleared = true;
+
+    m_isFadingOut = false;
+    m_tailOff = 1.0f;
+}
+
+void PhantomVoice::fadeOut() noexcept
+{
+    if(!isRendering()) return;
+
+    const float numFadeSamples = jmax(1.0f, Consts::_VOICE_STEAL_FADE_TIME * (float) getSampleRate());
+
+    m_isFadingOut = true;
+    m_tailOffDecay = powf(k_minTailOff, 1.0f / numFadeSamples);
+}
+
+void PhantomVoice::setModulationControlInterval(int interval, bool isAmpEnvAudioRate) noexcept
+{
+    m_ampEnv->setControlInterval(isAmpEnvAudioRate ? 1 : interval);
+    m_phaseEnv->setControlInterval(interval);
+    m_filterEnv->setControlInterval(interval);
+    m_modEnv->setControlInterval(interval);
+
+    m_lfo01->setControlInterval(interval);
+    m_lfo02->setControlInterval(interval);
+
+    m_filter->setControlInterval(interval);
+}
+
+void PhantomVoice::setOscillatorInterpolation(PhantomWavetable::Interpolation interpolation) noexcept
+{
+    m_primaryOsc->setInterpolation(interpolation);
+    m_secondaryOsc->setInterpolation(interpolation);
 }
 
 void PhantomVoice::renderNextBlock(AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
     if(numSamples == 0) return;
 
-    if(m_isNoteOn && !isKeyDown())
-        stopNote(0.0f, true);
+    update();
+
+    while(numSamples > 0 && isRendering())
+    {
+        const int numToRender = jmin(numSamples, m_blockSize);
+
+        renderModulation(numToRender);
+        m_bank.advanceLanePhases(m_lane, m_parameters.oscSync != 0.0f, numToRender);
+
+        renderOscillators(numToRender);
+        m_bank.filterLane(m_lane, m_filter->getMode(), numToRender);
 
+        float* monoMix = m_scratchBuffer.getWritePointer(MONO_MIX);
+        FloatVectorOperations::clear(monoMix, numToRender);
+        renderOutput(monoMix, numToRender);
+
+        for(int channel = 0; channel < buffer.getNumChannels(); channel++)
+            buffer.addFrom(channel, startSample, monoMix, numToRender);
+
+        startSample += numToRender;
+        numSamples -= numToRender;
+    }
+}
+
+void PhantomVoice::update() noexcept
+{
     const float sampleRate = (float) getSampleRate();
 
-    m_ampEnv->update(sampleRate);
-    m_phaseEnv->update(sampleRate);
-    m_filterEnv->update(sampleRate);
-    m_modEnv->update(sampleRate);
+    m_ampEnv->update(m_parameters.eg[EnvelopeType::AMP], sampleRate);
+    m_phaseEnv->update(m_parameters.eg[EnvelopeType::PHASOR], sampleRate);
+    m_filterEnv->update(m_parameters.eg[EnvelopeType::FILTER], sampleRate);
+    m_modEnv->update(m_parameters.eg[EnvelopeType::MOD], sampleRate);
 
-    m_lfo01->update(sampleRate);
-    m_lfo02->update(sampleRate);
+    m_lfo01->update(m_parameters.lfo[0], sampleRate);
+    m_lfo02->update(m_parameters.lfo[1], sampleRate);
 
-    m_primaryOsc->update(m_midiNoteNumber, sampleRate);
-    m_secondaryOsc->update(m_midiNoteNumber, sampleRate);
+    m_primaryOsc->update(m_parameters.osc[0], m_midiNoteNumber, sampleRate);
+    m_secondaryOsc->update(m_parameters.osc[1], m_midiNoteNumber, sampleRate);
     
-    m_filter->update();
+    m_filter->update(m_parameters.filter);
+}
 
-    for (int sampleIdx = 0; sampleIdx < numSamples; sampleIdx++)
+bool PhantomVoice::isRendering() const noexcept
+{
+    return !m_isNoteCleared;
+}
+
+void PhantomVoice::renderModulation(int numSamples) noexcept
+{
+    if(!isRendering())
+    {
+        m_bank.clearLane(m_lane, numSamples);
+        return;
+    }
+
+    float* phaseEnvMod = m_scratchBuffer.getWritePointer(PHASE_ENV);
+    float* filterEnvMod = m_scratchBuffer.getWritePointer(FILTER_ENV);
+    float* modEnvMod = m_scratchBuffer.getWritePointer(MOD_ENV);
+    float* primaryPhaseDeltas = m_scratchBuffer.getWritePointer(PRIMARY_PHASES);
+    float* secondaryPhaseDeltas = m_scratchBuffer.getWritePointer(SECONDARY_PHASES);
+
+    m_ampEnv->evaluate(m_scratchBuffer.getWritePointer(AMP_ENV), numSamples);
+    m_phaseEnv->evaluate(phaseEnvMod, numSamples);
+    m_filterEnv->evaluate(filterEnvMod, numSamples);
+    m_modEnv->evaluate(modEnvMod, numSamples);
+
+    if((int) m_parameters.lfo[0].mode != PhantomLFO::GLOBAL)
+        m_lfo01->evaluate(m_scratchBuffer.getWritePointer(LFO_01), numSamples);
+
+    if((int) m_parameters.lfo[1].mode != PhantomLFO::GLOBAL)
+        m_lfo02->evaluate(m_scratchBuffer.getWritePointer(LFO_02), numSamples);
+
+    const float* lfo02Mod = getLFOValues(1);
+
+    m_primaryOsc->evaluatePhaseDeltas(primaryPhaseDeltas, modEnvMod, lfo02Mod, numSamples);
+    m_secondaryOsc->evaluatePhaseDeltas(secondaryPhaseDeltas, modEnvMod, lfo02Mod, numSamples);
+
+    m_bank.writeLane(PhantomVoiceBank::PRIMARY_OSC, m_lane, primaryPhaseDeltas, numSamples);
+    m_bank.writeLane(PhantomVoiceBank::SECONDARY_OSC, m_lane, secondaryPhaseDeltas, numSamples);
+}
+
+void PhantomVoice::renderOscillators(int numSamples) noexcept
+{
+    if(!isRendering()) return;
+
+    const float* phaseEnvMod = m_scratchBuffer.getReadPointer(PHASE_ENV);
+    const float* filterEnvMod = m_scratchBuffer.getReadPointer(FILTER_ENV);
+    const float* lfo01Mod = getLFOValues(0);
+    const float* lfo02Mod = getLFOValues(1);
+    float* primaryPhases = m_scratchBuffer.getWritePointer(PRIMARY_PHASES);
+    float* secondaryPhases = m_scratchBuffer.getWritePointer(SECONDARY_PHASES);
+    float* primaryOscVals = m_scratchBuffer.getWritePointer(PRIMARY_OSC);
+    float* secondaryOscVals = m_scratchBuffer.getWritePointer(SECONDARY_OSC);
+    float* syncPositions = m_scratchBuffer.getWritePointer(SYNC_POSITIONS);
+    float* syncPhases = m_scratchBuffer.getWritePointer(SYNC_PHASES);
+    float* filterG = m_scratchBuffer.getWritePointer(FILTER_G);
+    float* filterH = m_scratchBuffer.getWritePointer(FILTER_H);
+    float* output = m_scratchBuffer.getWritePointer(OUTPUT);
+
+    m_bank.readLane(PhantomVoiceBank::PRIMARY_OSC, m_lane, primaryPhases, numSamples);
+    m_bank.readLane(PhantomVoiceBank::SECONDARY_OSC, m_lane, secondaryPhases, numSamples);
+
+    const bool isSynced = m_parameters.oscSync != 0.0f;
+
+    if(isSynced)
     {
-        float ampEnvMod = m_ampEnv->evaluate();
-        float phaseEnvMod = m_phaseEnv->evaluate();
-        float filterEnvMod = m_filterEnv->evaluate();
-        float modEnvMod = m_modEnv->evaluate();
+        m_bank.readLane(PhantomVoiceBank::SYNC_POSITIONS, m_lane, syncPositions, numSamples);
+        m_bank.readLane(PhantomVoiceBank::SYNC_PHASES, m_lane, syncPhases, numSamples);
+    }
+
+    m_primaryOsc->evaluate(primaryOscVals, primaryPhases, phaseEnvMod, lfo02Mod, nullptr, nullptr, numSamples);
+    m_secondaryOsc->evaluate(secondaryOscVals, secondaryPhases, phaseEnvMod, lfo02Mod, isSynced ? syncPositions : nullptr, syncPhases, numSamples);
+    m_mixer->evaluate(output, primaryOscVals, secondaryOscVals, numSamples);
+
+    m_filter->evaluate(output, filterG, filterH, filterEnvMod, lfo01Mod, numSamples);
+
+    m_bank.writeLane(PhantomVoiceBank::FILTER, m_lane, output, numSamples);
+    m_bank.writeLane(PhantomVoiceBank::FILTER_G, m_lane, filterG, numSamples);
+    m_bank.writeLane(PhantomVoiceBank::FILTER_H, m_lane, filterH, numSamples);
+    m_bank.setFilterResonance(m_lane, m_filter->getResonanceCoefficient());
+    m_bank.setFilterMode(m_lane, m_filter->getMode());
+}
+
+void PhantomVoice::renderOutput(float* dest, int numSamples) noexcept
+{
+    if(!isRendering()) return;
 
-        float lfo01Mod = m_lfo01->evaluate();
-        float lfo02Mod = m_lfo02->evaluate();
+    const float* ampEnvMod = m_scratchBuffer.getReadPointer(AMP_ENV);
+    float* output = m_scratchBuffer.getWritePointer(OUTPUT);
 
-        handleOscSync(m_primaryOsc->readPhase());
+    m_bank.readLane(PhantomVoiceBank::FILTER, m_lane, output, numSamples);
+    FloatVectorOperations::multiply(output, ampEnvMod, numSamples);
+    m_bank.setAmpLevel(m_lane, ampEnvMod[numSamples - 1]);
 
-        float primaryOscVal = m_primaryOsc->evaluate(modEnvMod, lfo02Mod, phaseEnvMod, lfo02Mod);
-        float secondaryOscVal = m_secondaryOsc->evaluate(modEnvMod, lfo02Mod, phaseEnvMod, lfo02Mod);
-        float oscVal = m_mixer->evaluate(primaryOscVal, secondaryOscVal);
+    applyTailOff(output, numSamples);
 
-        float filterVal = m_filter->evaluate(oscVal, filterEnvMod, lfo01Mod);
-        float ampVal = filterVal * ampEnvMod;
+    /** NOTE: The voice is freed once its note is released and the amplifier envelope has finished. */
+    const bool isReleased = !m_isNoteOn && !m_ampEnv->isActive();
 
-        if(isVoiceActive()) m_tailOff = 1.0f;
-        float finalVal = ampVal * m_tailOff;
+    FloatVectorOperations::add(dest, output, numSamples);
 
-        m_tailOff *= 0.99f;
-        if(!m_isNoteCleared && m_tailOff < 0.001f)
-            clear();
+    if(isReleased && !m_isNoteCleared)
+        clear();
+}
+
+void PhantomVoice::applyTailOff(float* samples, int numSamples) noexcept
+{
+    if(!m_isFadingOut) return;
 
-        for (int channelIdx = 0; channelIdx < buffer.getNumChannels(); channelIdx++)
-            buffer.addSample(channelIdx, sampleIdx + startSample, finalVal);
+    for (int sampleIdx = 0; sampleIdx < numSamples; sampleIdx++)
+    {
+        samples[sampleIdx] *= m_tailOff;
+        m_tailOff *= m_tailOffDecay;
     }
+
+    if(!m_isNoteCleared && m_tailOff < k_minTailOff)
+        clear();
 }
 
-void PhantomVoice::handleOscSync(const float valueToRead) noexcept
+const float* PhantomVoice::getLFOValues(int lfo) const noexcept
 {
-    if(!*p_oscSync) return;
+    if((int) m_parameters.lfo[lfo].mode == PhantomLFO::GLOBAL)
+        return m_globalModulation.lfo[lfo];
 
-    if(valueToRead <= k_oscSyncPhaseThreshold)
-        m_secondaryOsc->updatePhase(valueToRead);
+    return m_scratchBuffer.getReadPointer(lfo == 0 ? LFO_01 : LFO_02);
 }
@@ -18,6 +18,8 @@
 #include "../generators/PhantomEnvelope.h"
 #include "../generators/PhantomLFO.h"
 #include "../generators/PhantomOscillator.h"
+#include "PhantomVoiceBank.h"
+#include "../utils/PhantomParameters.h"
 
 /**
  * The class overriding JUCE's `SynthesiserVoice`, which is necessary for creating
@@ -27,7 +29,7 @@
 class PhantomVoice : public SynthesiserVoice
 {
 public:
-    PhantomVoice(AudioProcessorValueTreeState&, dsp::ProcessSpec&);
+    PhantomVoice(const PhantomParameters&, const PhantomRamps&, const PhantomGlobalModulation&, dsp::ProcessSpec&, PhantomVoiceBank&, int);
     ~PhantomVoice();
 
     /**
@@ -66,8 +68,32 @@ public:
      */
     void stopNote(float velocity, bool allowTailOff) override;
 
+    /**
+     * Resets every component of the voice and clears the current note, which frees the voice.
+     */
     void clear();
 
+    /**
+     * Starts a short fade out of the voice, after which it is cleared. Used when the voice is
+     * stolen so the note doesn't stop with a click.
+     */
+    void fadeOut() noexcept;
+
+    /**
+     * Sets the rate the envelopes and LFOs of the voice are computed at.
+     * @param interval The number of samples between computed modulation values, which are
+     * linearly interpolated (1 computes every sample).
+     * @param isAmpEnvAudioRate Whether the amplifier envelope is still computed every sample,
+     * which keeps fast attacks accurate.
+     */
+    void setModulationControlInterval(int interval, bool isAmpEnvAudioRate) noexcept;
+
+    /**
+     * Sets the interpolation mode of both oscillators' wavetable reads.
+     * @param interpolation The interpolation mode to read the wavetables with.
+     */
+    void setOscillatorInterpolation(PhantomWavetable::Interpolation interpolation) noexcept;
+
     /**
      * Applies all components of the `PhantomSynth` engine to the audio buffer.
      * @param buffer A reference to the audio buffer to write to.
@@ -76,14 +102,97 @@ public:
      */
     void renderNextBlock(AudioBuffer<float>& buffer, int startSample, int numSamples) override;
 
+    /**
+     * Updates the parameters of every component of the voice from the synth's parameter 
+     * snapshot, called once before the voice's stages are rendered for a block.
+     */
+    void update() noexcept;
+
+    /**
+     * @returns `true` if the voice has a note that still needs to be rendered.
+     */
+    bool isRendering() const noexcept;
+
+    /**
+     * NOTE: The following stages are run in order by `PhantomSynth` for every voice of a 
+     * `PhantomVoiceBank` group, with the bank's kernels run in between them. 
+     * CAUTION: `numSamples` must not exceed the size of the scratch buffer (`m_blockSize`).
+     */
+
+    /**
+     * Renders the envelopes and LFOs (unless they are global), then writes the oscillator phase deltas to the bank.
+     * @param numSamples The number of samples to render.
+     */
+    void renderModulation(int numSamples) noexcept;
+
+    /**
+     * Reads the accumulated phases from the bank, renders the oscillators and mixer, then 
+     * writes the driven signal, filter coefficients and (smoothed) resonance to the bank.
+     * @param numSamples The number of samples to render.
+     */
+    void renderOscillators(int numSamples) noexcept;
+
+    /**
+     * Reads the filtered signal from the bank, applies the amplifier envelope and adds the 
+     * result to a mono mix, which the synth adds to every output channel.
+     * @param dest The mono mix to add the voice to.
+     * @param numSamples The number of samples to write.
+     */
+    void renderOutput(float* dest, int numSamples) noexcept;
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomVoice)
 
     /**
-     * Resets phase of secondary oscillator if given value is less than or equal to `k_oscSyncPhaseThreshold`.
-     * @param valueToRead The value to check for phase equality.
+     * Applies the fade out multiplier to a block of samples (if the voice is fading out),
+     * clearing the note once it becomes inaudible.
+     * @param samples The sample values to apply the tail off to.
+     * @param numSamples The number of sample values.
      */
-    void handleOscSync(float valueToRead) noexcept;
+    void applyTailOff(float* samples, int numSamples) noexcept;
+
+    /**
+     * @param lfo The index of the LFO.
+     * @returns The LFO's values for the samples being rendered, which are read from the synth's
+     * global LFO if it is in global mode.
+     */
+    const float* getLFOValues(int lfo) const noexcept;
+
+    /**
+     * Enumerator with the channel indices of the scratch buffer, one for each 
+     * intermediate signal of the voice.
+     */
+    enum ScratchChannel
+    {
+        AMP_ENV = 0,
+        PHASE_ENV,
+        FILTER_ENV,
+        MOD_ENV,
+        LFO_01,
+        LFO_02,
+        PRIMARY_PHASES,
+        SECONDARY_PHASES,
+        PRIMARY_OSC,
+        SECONDARY_OSC,
+        SYNC_POSITIONS,
+        SYNC_PHASES,
+        FILTER_G,
+        FILTER_H,
+        OUTPUT,
+        MONO_MIX,
+        NUM_SCRATCH_CHANNELS
+    };
+
+    /**
+     * The buffer holding the intermediate signals of the voice for a block, which is
+     * allocated up front so that rendering never allocates.
+     */
+    AudioBuffer<float> m_scratchBuffer;
+
+    /**
+     * The maximum number of samples rendered by a single pass of the voice stages.
+     */
+    int m_blockSize = 0;
 
     /**
      * The unique pointer for the amplifier envelope generator.
@@ -138,29 +247,31 @@ private:
      */
     std::unique_ptr<PhantomFilter> m_filter;
 
-    AudioProcessorValueTreeState& m_parameters;
+    /**
+     * The reference to the synth's parameter snapshot for the current block.
+     */
+    const PhantomParameters& m_parameters;
 
     /**
-     * The atomic parameter pointer for oscillator sync.
+     * The reference to the synth's global LFO values for the samples being rendered.
      */
-    std::atomic<float>* p_oscSync;
+    const PhantomGlobalModulation& m_globalModulation;
 
     /**
-     * Integer value for the current note MIDI pitch value. 
-     * NOTE: 60 corresponds to middle C (C4).
+     * The reference to the voice bank holding the oscillator phases and filter state of every voice.
      */
-    int m_midiNoteNumber = 60;
-    
+    PhantomVoiceBank& m_bank;
+
     /**
-     * Boolean value for if the oscillator sync is turned on (true) or off (false).
+     * The lane of the voice bank that belongs to this voice.
      */
-    bool m_oscSyncToggle = false;
+    const int m_lane;
 
     /**
-     * Constant float value for checking zero-crossings in phase. This value is based on the wavetable implementation 
-     * meaning that this variables range is within the size of that wavetable.
+     * Integer value for the current note MIDI pitch value. 
+     * NOTE: 60 corresponds to middle C (C4).
      */
-    const float k_oscSyncPhaseThreshold = 0.2f;
+    int m_midiNoteNumber = 60;
 
     /**
      * Boolean value that is true when the note is in any stage but the release stage.
@@ -171,16 +282,26 @@ private:
      * Boolean value that is true when when the envelopes have completed.
      */
     bool m_isNoteCleared = true;
-    
+
     /**
-     * Float value for velocity of a note, useful in calling `stopNote()` at any time.
+     * Boolean value that is true while the voice fades out after being stolen.
      */
-    float m_velocity = -1.0f;
+    bool m_isFadingOut = false;
 
     /**
      * Multiplier for smoothing abrupt releases of notes.
      */
-    float m_tailOff = 0.0f;
+    float m_tailOff = 1.0f;
+
+    /**
+     * The per-sample decay of the tail off multiplier while fading out.
+     */
+    float m_tailOffDecay = 0.99f;
+
+    /**
+     * The tail off level below which the voice is inaudible and gets cleared.
+     */
+    const float k_minTailOff = 0.001f;
 };
 
 #endif
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    PhantomVoiceAllocator.cpp
+    Created: 17 Oct 2026 15:05:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomVoiceAllocator.h"
+
+PhantomVoiceAllocator::PhantomVoiceAllocator(int numVoices)
+{
+    m_freeVoices.ensureStorageAllocated(numVoices);
+
+    /** NOTE: The lowest voices are allocated first, which keeps the voice bank groups packed. */
+    for(int voice = numVoices - 1; voice >= 0; voice--)
+        m_freeVoices.add(voice);
+
+    m_states.insertMultiple(0, FREE, numVoices);
+    m_notes.insertMultiple(0, -1, numVoices);
+    m_olderVoices.insertMultiple(0, -1, numVoices);
+    m_newerVoices.insertMultiple(0, -1, numVoices);
+    m_previousNoteVoices.insertMultiple(0, -1, numVoices);
+    m_nextNoteVoices.insertMultiple(0, -1, numVoices);
+
+    for(int note = 0; note < 128; note++)
+        m_noteVoices[note] = -1;
+}
+
+PhantomVoiceAllocator::~PhantomVoiceAllocator()
+{
+
+}
+
+int PhantomVoiceAllocator::allocate(int midiNoteNumber) noexcept
+{
+    if(m_freeVoices.isEmpty())
+        return -1;
+
+    const int voice = m_freeVoices.removeAndReturn(m_freeVoices.size() - 1);
+    const int note = midiNoteNumber & 127;
+
+    m_states.set(voice, PLAYING);
+    m_notes.set(voice, note);
+    m_numPlaying++;
+
+    m_olderVoices.set(voice, m_newestVoice);
+    m_newerVoices.set(voice, -1);
+
+    if(m_newestVoice >= 0)
+        m_newerVoices.set(m_newestVoice, voice);
+    else
+        m_oldestVoice = voice;
+
+    m_newestVoice = voice;
+
+    m_previousNoteVoices.set(voice, -1);
+    m_nextNoteVoices.set(voice, m_noteVoices[note]);
+
+    if(m_noteVoices[note] >= 0)
+        m_previousNoteVoices.set(m_noteVoices[note], voice);
+
+    m_noteVoices[note] = voice;
+
+    return voice;
+}
+
+void PhantomVoiceAllocator::steal(int voice) noexcept
+{
+    if(m_states[voice] != PLAYING)
+        return;
+
+    removeFromNote(voice);
+
+    m_states.set(voice, STOLEN);
+    m_numPlaying--;
+}
+
+void PhantomVoiceAllocator::release(int voice) noexcept
+{
+    if(m_states[voice] == FREE)
+        return;
+
+    if(m_states[voice] == PLAYING)
+    {
+        removeFromNote(voice);
+        m_numPlaying--;
+    }
+
+    const int older = m_olderVoices[voice];
+    const int newer = m_newerVoices[voice];
+
+    if(older >= 0)
+        m_newerVoices.set(older, newer);
+    else
+        m_oldestVoice = newer;
+
+    if(newer >= 0)
+        m_olderVoices.set(newer, older);
+    else
+        m_newestVoice = older;
+
+    m_states.set(voice, FREE);
+    m_freeVoices.add(voice);
+}
+
+void PhantomVoiceAllocator::removeFromNote(int voice) noexcept
+{
+    const int note = m_notes[voice];
+    const int previous = m_previousNoteVoices[voice];
+    const int next = m_nextNoteVoices[voice];
+
+    if(previous >= 0)
+        m_nextNoteVoices.set(previous, next);
+    else
+        m_noteVoices[note] = next;
+
+    if(next >= 0)
+        m_previousNoteVoices.set(next, previous);
+
+    m_notes.set(voice, -1);
+}
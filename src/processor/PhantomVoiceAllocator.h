@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    PhantomVoiceAllocator.h
+    Created: 17 Oct 2026 15:05:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_VOICE_ALLOCATOR_H
+#define _PHANTOM_VOICE_ALLOCATOR_H
+
+#include "JuceHeader.h"
+
+/**
+ * The bookkeeping for which voices of the synth are in use, replacing the linear
+ * scans of JUCE's `Synthesiser`. Free voices are kept on a stack, voices in use are
+ * linked in the order they were started (oldest first) and playing voices are also
+ * linked per MIDI note, so allocating, releasing and looking up a note are O(1).
+ *
+ * CAUTION: The allocator isn't thread-safe and must only be used from the audio thread.
+ */
+class PhantomVoiceAllocator
+{
+public:
+    PhantomVoiceAllocator(int numVoices);
+    ~PhantomVoiceAllocator();
+
+    /**
+     * Enumerator with the states of a voice.
+     * @property FREE The voice is idle and on the free stack.
+     * @property PLAYING The voice is playing a note (including its release) and counts towards the polyphony.
+     * @property STOLEN The voice is fading out after being stolen, still holding its lane but not a note.
+     */
+    enum VoiceState
+    {
+        FREE = 0,
+        PLAYING,
+        STOLEN
+    };
+
+    /**
+     * Enumerator with the strategies for choosing the voice to steal, which match
+     * the values of the voice steal parameter.
+     * @property OLDEST Steals the voice that was started first.
+     * @property QUIETEST Steals the voice with the lowest amplifier envelope level.
+     * @property RELEASED Steals the oldest voice whose key was released, falling back to the oldest voice.
+     */
+    enum StealMode
+    {
+        OLDEST = 0,
+        QUIETEST,
+        RELEASED
+    };
+
+    /**
+     * Takes a voice off the free stack and marks it as playing a note.
+     * @param midiNoteNumber The MIDI note the voice is allocated for.
+     * @returns The index of the voice, or -1 if every voice is in use.
+     */
+    int allocate(int midiNoteNumber) noexcept;
+
+    /**
+     * Marks a playing voice as stolen, which removes it from the polyphony count and note
+     * lookup while it fades out.
+     * @param voice The index of the voice.
+     */
+    void steal(int voice) noexcept;
+
+    /**
+     * Returns a voice to the free stack.
+     * @param voice The index of the voice.
+     */
+    void release(int voice) noexcept;
+
+    /**
+     * @param voice The index of the voice.
+     * @returns The state of the voice.
+     */
+    VoiceState getState(int voice) const noexcept { return (VoiceState) m_states[voice]; };
+
+    /** @returns The number of voices in the `PLAYING` state. */
+    int getNumPlaying() const noexcept { return m_numPlaying; };
+
+    /** @returns The voice in use that was started first, or -1 if no voice is in use. */
+    int getOldestVoice() const noexcept { return m_oldestVoice; };
+
+    /**
+     * @param voice The index of a voice in use.
+     * @returns The next voice in use that was started after it, or -1 if it is the newest.
+     */
+    int getNextNewerVoice(int voice) const noexcept { return m_newerVoices[voice]; };
+
+    /**
+     * @param midiNoteNumber The MIDI note to look up.
+     * @returns The most recently started voice playing the note, or -1 if there is none.
+     */
+    int getFirstVoiceForNote(int midiNoteNumber) const noexcept { return m_noteVoices[midiNoteNumber & 127]; };
+
+    /**
+     * @param voice The index of a playing voice.
+     * @returns The next (older) voice playing the same note, or -1 if there is none.
+     */
+    int getNextVoiceForNote(int voice) const noexcept { return m_nextNoteVoices[voice]; };
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomVoiceAllocator)
+
+    /**
+     * Unlinks a playing voice from the list of its note.
+     * @param voice The index of the voice.
+     */
+    void removeFromNote(int voice) noexcept;
+
+    /** The free voices, with the next voice to allocate at the end. */
+    Array<int> m_freeVoices;
+
+    /** The state of each voice (a `VoiceState`). */
+    Array<int> m_states;
+
+    /** The MIDI note of each playing voice. */
+    Array<int> m_notes;
+
+    /** The previous (older) voice in use for each voice in use. */
+    Array<int> m_olderVoices;
+
+    /** The next (newer) voice in use for each voice in use. */
+    Array<int> m_newerVoices;
+
+    /** The previous (newer) voice playing the same note for each playing voice. */
+    Array<int> m_previousNoteVoices;
+
+    /** The next (older) voice playing the same note for each playing voice. */
+    Array<int> m_nextNoteVoices;
+
+    /** The most recently started voice for each MIDI note. */
+    int m_noteVoices[128];
+
+    /** The voice in use that was started first. */
+    int m_oldestVoice = -1;
+
+    /** The voice in use that was started last. */
+    int m_newestVoice = -1;
+
+    /** The number of voices in the `PLAYING` state. */
+    int m_numPlaying = 0;
+};
+
+#endif
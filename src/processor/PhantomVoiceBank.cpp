@@ -0,0 +1,507 @@
+/*
+  ==============================================================================
+
+    PhantomVoiceBank.cpp
+    Created: 17 Oct 2026 10:12:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomVoiceBank.h"
+
+#include "../utils/PhantomUtils.h"
+
+/** The number of per-lane state arrays held in front of the block data. */
+static constexpr int k_numLaneStates = 6;
+
+/** The number of filter modes (and outputs). */
+static constexpr int k_numFilterModes = 4;
+
+/** The filter mode of the ladder. */
+static constexpr int k_ladderMode = 3;
+
+/** The input where a ladder stage's saturation reaches its peak (of 1), and the cubic coefficient that puts it there. */
+static constexpr float k_stageLimit = 1.5f;
+static constexpr float k_stageCurve = 4.0f / 27.0f;
+
+PhantomVoiceBank::PhantomVoiceBank(int numVoices, int blockSize)
+{
+    m_numGroups = (jmax(1, numVoices) + k_laneWidth - 1) / k_laneWidth;
+    m_numLanes = m_numGroups * k_laneWidth;
+    m_blockSize = jmax(1, blockSize);
+
+    const size_t numStateFloats = (size_t) (k_numLaneStates * m_numLanes);
+    const size_t numBlockFloats = (size_t) (m_numGroups * NUM_BANK_CHANNELS * m_blockSize * k_laneWidth);
+
+    m_memory.calloc(numStateFloats + numBlockFloats + (size_t) k_laneWidth);
+    m_phaseMemory.calloc((size_t) (2 * m_numLanes));
+    m_maskMemory.calloc((size_t) (k_numFilterModes * m_numLanes + k_laneWidth));
+
+    float* data = FloatVec::getNextSIMDAlignedPtr(m_memory.get());
+
+    m_primaryPhases = m_phaseMemory.get();
+    m_secondaryPhases = m_primaryPhases + m_numLanes;
+
+    m_filterModeMasks = MaskVec::getNextSIMDAlignedPtr(m_maskMemory.get());
+
+    m_filterS1 = data;
+    m_filterS2 = m_filterS1 + m_numLanes;
+    m_filterS3 = m_filterS2 + m_numLanes;
+    m_filterS4 = m_filterS3 + m_numLanes;
+    m_filterR2 = m_filterS4 + m_numLanes;
+    m_ampLevels = m_filterR2 + m_numLanes;
+    m_blockData = m_ampLevels + m_numLanes;
+
+    for(int lane = 0; lane < m_numLanes; lane++)
+    {
+        setFilterResonance(lane, MathConstants<float>::sqrt2);
+        setFilterMode(lane, 0);
+    }
+}
+
+PhantomVoiceBank::~PhantomVoiceBank()
+{
+    m_blockData = nullptr;
+
+    m_primaryPhases = nullptr;
+    m_secondaryPhases = nullptr;
+    m_filterS1 = nullptr;
+    m_filterS2 = nullptr;
+    m_filterS3 = nullptr;
+    m_filterS4 = nullptr;
+    m_filterR2 = nullptr;
+    m_filterModeMasks = nullptr;
+    m_ampLevels = nullptr;
+}
+
+float* PhantomVoiceBank::getGroupData(int group, int channel) const noexcept
+{
+    return m_blockData + ((group * NUM_BANK_CHANNELS + channel) * m_blockSize * k_laneWidth);
+}
+
+float* PhantomVoiceBank::getLaneData(int lane, int channel) const noexcept
+{
+    return getGroupData(lane / k_laneWidth, channel) + (lane % k_laneWidth);
+}
+
+void PhantomVoiceBank::resetLane(int lane) noexcept
+{
+    m_primaryPhases[lane] = 0;
+    m_secondaryPhases[lane] = 0;
+
+    m_filterS1[lane] = 0.0f;
+    m_filterS2[lane] = 0.0f;
+    m_filterS3[lane] = 0.0f;
+    m_filterS4[lane] = 0.0f;
+    m_ampLevels[lane] = 0.0f;
+
+    /** NOTE: An idle lane is back in the state-variable mode, so it doesn't keep its group on the ladder. */
+    setFilterMode(lane, 0);
+}
+
+void PhantomVoiceBank::clearLane(int lane, int numSamples) noexcept
+{
+    for(int channel = 0; channel < NUM_BANK_CHANNELS; channel++)
+    {
+        float* data = getLaneData(lane, channel);
+
+        for(int i = 0; i < numSamples; i++)
+            data[i * k_laneWidth] = 0.0f;
+    }
+}
+
+void PhantomVoiceBank::writeLane(BankChannel channel, int lane, const float* source, int numSamples) noexcept
+{
+    jassert(numSamples <= m_blockSize);
+
+    float* data = getLaneData(lane, channel);
+
+    for(int i = 0; i < numSamples; i++)
+        data[i * k_laneWidth] = source[i];
+}
+
+void PhantomVoiceBank::readLane(BankChannel channel, int lane, float* dest, int numSamples) const noexcept
+{
+    jassert(numSamples <= m_blockSize);
+
+    const float* data = getLaneData(lane, channel);
+
+    for(int i = 0; i < numSamples; i++)
+        dest[i] = data[i * k_laneWidth];
+}
+
+void PhantomVoiceBank::setFilterResonance(int lane, float coefficient) noexcept
+{
+    m_filterR2[lane] = coefficient;
+}
+
+void PhantomVoiceBank::setFilterMode(int lane, int mode) noexcept
+{
+    mode = jlimit(0, k_numFilterModes - 1, mode);
+
+    for(int output = 0; output < k_numFilterModes; output++)
+        m_filterModeMasks[output * m_numLanes + lane] = output == mode ? 0xffffffffu : 0u;
+}
+
+void PhantomVoiceBank::setAmpLevel(int lane, float level) noexcept
+{
+    m_ampLevels[lane] = level;
+}
+
+float PhantomVoiceBank::getAmpLevel(int lane) const noexcept
+{
+    return m_ampLevels[lane];
+}
+
+/**
+ * Computes the position of a hard sync reset within a sample period.
+ * @param nextPrimaryPhase The primary phase at the next sample (past the wrap).
+ * @param primaryDelta The primary phase delta.
+ * @returns The fraction of the sample period before the primary phase wraps, in the range [0, 1].
+ */
+static inline float getSyncPosition(uint32 nextPrimaryPhase, uint32 primaryDelta) noexcept
+{
+    return jlimit(0.0f, 1.0f, 1.0f - (float) nextPrimaryPhase / (float) jmax(primaryDelta, (uint32) 1));
+}
+
+void PhantomVoiceBank::advancePhases(int group, bool isSynced, int numSamples) noexcept
+{
+    const int firstLane = group * k_laneWidth;
+
+    float* primary = getGroupData(group, PRIMARY_OSC);
+    float* secondary = getGroupData(group, SECONDARY_OSC);
+    float* syncPositions = getGroupData(group, SYNC_POSITIONS);
+    float* syncPhases = getGroupData(group, SYNC_PHASES);
+
+    uint32 primaryPhases[k_laneWidth];
+    uint32 secondaryPhases[k_laneWidth];
+
+    for(int lane = 0; lane < k_laneWidth; lane++)
+    {
+        primaryPhases[lane] = m_primaryPhases[firstLane + lane];
+        secondaryPhases[lane] = m_secondaryPhases[firstLane + lane];
+    }
+
+    /**
+     * NOTE: The lane loop only tests `isSynced`, which is fixed for the block, so the optimizer moves
+     * the test out of the loops and the lane loop vectorizes across the group.
+     */
+    for(int i = 0; i < numSamples; i++)
+    {
+        const int idx = i * k_laneWidth;
+
+        for(int lane = 0; lane < k_laneWidth; lane++)
+        {
+            const uint32 primaryDelta = phaseToFixed(primary[idx + lane]);
+            const uint32 secondaryDelta = phaseToFixed(secondary[idx + lane]);
+
+            primary[idx + lane] = fixedToPhase(primaryPhases[lane]);
+            secondary[idx + lane] = fixedToPhase(secondaryPhases[lane]);
+
+            const uint32 nextPrimaryPhase = primaryPhases[lane] + primaryDelta;
+            const bool isReset = nextPrimaryPhase < primaryPhases[lane];
+
+            primaryPhases[lane] = nextPrimaryPhase;
+
+            if(!isSynced)
+            {
+                secondaryPhases[lane] += secondaryDelta;
+                continue;
+            }
+
+            const float position = getSyncPosition(nextPrimaryPhase, primaryDelta);
+            const uint32 resetPhase = (uint32) ((1.0f - position) * (float) secondaryDelta);
+
+            syncPositions[idx + lane] = isReset ? position : 0.0f;
+            syncPhases[idx + lane] = fixedToPhase(secondaryPhases[lane] + (uint32) (position * (float) secondaryDelta));
+
+            secondaryPhases[lane] = isReset ? resetPhase : secondaryPhases[lane] + secondaryDelta;
+        }
+    }
+
+    for(int lane = 0; lane < k_laneWidth; lane++)
+    {
+        m_primaryPhases[firstLane + lane] = primaryPhases[lane];
+        m_secondaryPhases[firstLane + lane] = secondaryPhases[lane];
+    }
+}
+
+void PhantomVoiceBank::advanceLanePhases(int lane, bool isSynced, int numSamples) noexcept
+{
+    float* primary = getLaneData(lane, PRIMARY_OSC);
+    float* secondary = getLaneData(lane, SECONDARY_OSC);
+    float* syncPositions = getLaneData(lane, SYNC_POSITIONS);
+    float* syncPhases = getLaneData(lane, SYNC_PHASES);
+
+    uint32 primaryPhase = m_primaryPhases[lane];
+    uint32 secondaryPhase = m_secondaryPhases[lane];
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        const int idx = i * k_laneWidth;
+
+        const uint32 primaryDelta = phaseToFixed(primary[idx]);
+        const uint32 secondaryDelta = phaseToFixed(secondary[idx]);
+
+        primary[idx] = fixedToPhase(primaryPhase);
+        secondary[idx] = fixedToPhase(secondaryPhase);
+
+        const uint32 nextPrimaryPhase = primaryPhase + primaryDelta;
+        const bool isReset = nextPrimaryPhase < primaryPhase;
+
+        primaryPhase = nextPrimaryPhase;
+
+        if(!isSynced)
+        {
+            secondaryPhase += secondaryDelta;
+            continue;
+        }
+
+        const float position = getSyncPosition(nextPrimaryPhase, primaryDelta);
+
+        syncPositions[idx] = isReset ? position : 0.0f;
+        syncPhases[idx] = fixedToPhase(secondaryPhase + (uint32) (position * (float) secondaryDelta));
+
+        secondaryPhase = isReset ? (uint32) ((1.0f - position) * (float) secondaryDelta) : secondaryPhase + secondaryDelta;
+    }
+
+    m_primaryPhases[lane] = primaryPhase;
+    m_secondaryPhases[lane] = secondaryPhase;
+}
+
+/**
+ * Clamps the input of a ladder stage to the range of its saturation.
+ */
+static inline float clipStage(float v) noexcept
+{
+    return jlimit(-k_stageLimit, k_stageLimit, v);
+}
+
+static inline PhantomVoiceBank::FloatVec clipStage(PhantomVoiceBank::FloatVec v) noexcept
+{
+    using FloatVec = PhantomVoiceBank::FloatVec;
+    return FloatVec::min(FloatVec::max(v, FloatVec::expand(-k_stageLimit)), FloatVec::expand(k_stageLimit));
+}
+
+/**
+ * Evaluates a one-pole stage of the ladder, whose input is saturated with the cubic `v - 4/27 * v^3`.
+ * The cubic is tanh-like (unity gain at 0, a soft knee up to +/- 1) but needs neither a division nor a table.
+ * NOTE: The stage gain is folded into the cubic's coefficients, which keeps the serial chain of the stages short.
+ * @param v The input of the stage.
+ * @param G The one-pole gain.
+ * @param Gc The one-pole gain times the (negated) cubic coefficient.
+ * @param b The state term of the stage (`(1 - G) * s`).
+ * @param slope The value to write the slope of the stage output at the input to (0 once clamped).
+ * @returns The output of the stage.
+ */
+template <typename Value>
+static inline Value evaluateLadderStage(Value v, Value G, Value Gc, Value b, Value& slope) noexcept
+{
+    v = clipStage(v);
+
+    const Value v2 = v * v;
+    slope = v2 * Gc * 3.0f + G;
+
+    return v * (v2 * Gc + G) + b;
+}
+
+/**
+ * Advances the zero-delay-feedback ladder by one sample (with the same code for a lane or a group of lanes).
+ *
+ * The feedback `u = x - k * y4(u)` is first solved as if the stages were linear, which is exact for small
+ * signals, and the stages are evaluated once at that input. A chord Newton step then refines the input,
+ * reusing the linear slope of the feedback (its reciprocal is `h`) so it needs no division, and the stage
+ * outputs follow it along their slopes instead of through a second pass over the stages.
+ *
+ * The cost of the filter is set by the serial chain from the states back to the states, so everything that
+ * only depends on the coefficients (the feedback weights of the states, the slopes) is kept off that chain.
+ * @param x The input sample.
+ * @param G The one-pole gain (`g / (1 + g)`).
+ * @param h The feedback gain (`1 / (1 + k * G^4)`).
+ * @param k The feedback (resonance) amount.
+ * @param s The four integrator states, which are advanced.
+ * @returns The output of the ladder.
+ */
+template <typename Value>
+static inline Value evaluateLadder(Value x, Value G, Value h, Value k, Value* s) noexcept
+{
+    const Value H = G * -1.0f + 1.0f;
+    const Value kh = k * h;
+    const Value Gc = G * -k_stageCurve;
+
+    /** NOTE: The linear solution `u = (x - k * sum(G^(3 - i) * H * s[i])) * h`, with the weights of the states first. */
+    const Value w3 = H * kh;
+    const Value w2 = w3 * G;
+    const Value w1 = w2 * G;
+    const Value w0 = w1 * G;
+
+    const Value u = x * h - ((w0 * s[0] + w1 * s[1]) + (w2 * s[2] + w3 * s[3]));
+
+    Value y[4];
+    Value dy[4];
+    Value slope;
+
+    y[0] = evaluateLadderStage(u, G, Gc, s[0] * H, slope);
+    dy[0] = slope;
+
+    y[1] = evaluateLadderStage(y[0], G, Gc, s[1] * H, slope);
+    dy[1] = dy[0] * slope;
+
+    y[2] = evaluateLadderStage(y[1], G, Gc, s[2] * H, slope);
+    dy[2] = dy[1] * slope;
+
+    y[3] = evaluateLadderStage(y[2], G, Gc, s[3] * H, slope);
+    dy[3] = dy[2] * slope;
+
+    const Value du = (u - x) * h + kh * y[3];
+
+    for(int i = 0; i < 4; i++)
+    {
+        y[i] = y[i] - dy[i] * du;
+        s[i] = y[i] * 2.0f - s[i];
+    }
+
+    return y[3];
+}
+
+void PhantomVoiceBank::filter(int group, int numSamples) noexcept
+{
+    const int firstLane = group * k_laneWidth;
+    const uint32* ladderMasks = m_filterModeMasks + k_ladderMode * m_numLanes + firstLane;
+
+    bool hasLadder = false;
+    bool hasStateVariable = false;
+
+    for(int lane = 0; lane < k_laneWidth; lane++)
+    {
+        if(ladderMasks[lane] != 0)
+            hasLadder = true;
+        else
+            hasStateVariable = true;
+    }
+
+    float* samples = getGroupData(group, FILTER);
+    const float* gs = getGroupData(group, FILTER_G);
+    const float* hs = getGroupData(group, FILTER_H);
+
+    FloatVec s1 = FloatVec::fromRawArray(m_filterS1 + firstLane);
+    FloatVec s2 = FloatVec::fromRawArray(m_filterS2 + firstLane);
+    FloatVec s3 = FloatVec::fromRawArray(m_filterS3 + firstLane);
+    FloatVec s4 = FloatVec::fromRawArray(m_filterS4 + firstLane);
+    const FloatVec resonance = FloatVec::fromRawArray(m_filterR2 + firstLane);
+
+    const MaskVec lowPassMask = MaskVec::fromRawArray(m_filterModeMasks + firstLane);
+    const MaskVec bandPassMask = MaskVec::fromRawArray(m_filterModeMasks + m_numLanes + firstLane);
+    const MaskVec highPassMask = MaskVec::fromRawArray(m_filterModeMasks + 2 * m_numLanes + firstLane);
+    const MaskVec ladderMask = MaskVec::fromRawArray(m_filterModeMasks + k_ladderMode * m_numLanes + firstLane);
+    const MaskVec stateVariableMask = lowPassMask | bandPassMask | highPassMask;
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        const int idx = i * k_laneWidth;
+
+        const FloatVec x = FloatVec::fromRawArray(samples + idx);
+        const FloatVec g = FloatVec::fromRawArray(gs + idx);
+        const FloatVec h = FloatVec::fromRawArray(hs + idx);
+
+        FloatVec ladderStates[4] = { s1, s2, s3, s4 };
+        FloatVec y = FloatVec::expand(0.0f);
+
+        if(hasLadder)
+            y = evaluateLadder(x, g, h, resonance, ladderStates) & ladderMask;
+
+        if(hasStateVariable)
+        {
+            const FloatVec yHP = h * (x - s1 * (g + resonance) - s2);
+
+            const FloatVec yBP = yHP * g + s1;
+            s1 = yHP * g + yBP;
+
+            const FloatVec yLP = yBP * g + s2;
+            s2 = yBP * g + yLP;
+
+            /** NOTE: Exactly one mask of a lane is set, so the sum keeps the output of its mode. */
+            y = y + (yLP & lowPassMask) + (yBP & bandPassMask) + (yHP & highPassMask);
+        }
+
+        /**
+         * NOTE: The ladder shares the first two states with the state-variable filter, which are blended the same way.
+         * The last two only belong to the ladder, so they are cleared for the other lanes (as `filterLane()` does),
+         * even in groups without a ladder lane, so a lane always comes back to the ladder from rest.
+         */
+        if(hasLadder)
+        {
+            s1 = (s1 & stateVariableMask) + (ladderStates[0] & ladderMask);
+            s2 = (s2 & stateVariableMask) + (ladderStates[1] & ladderMask);
+        }
+
+        s3 = ladderStates[2] & ladderMask;
+        s4 = ladderStates[3] & ladderMask;
+
+        y.copyToRawArray(samples + idx);
+    }
+
+    s1.copyToRawArray(m_filterS1 + firstLane);
+    s2.copyToRawArray(m_filterS2 + firstLane);
+    s3.copyToRawArray(m_filterS3 + firstLane);
+    s4.copyToRawArray(m_filterS4 + firstLane);
+
+    for(int lane = firstLane; lane < firstLane + k_laneWidth; lane++)
+    {
+        JUCE_SNAP_TO_ZERO(m_filterS1[lane]);
+        JUCE_SNAP_TO_ZERO(m_filterS2[lane]);
+        JUCE_SNAP_TO_ZERO(m_filterS3[lane]);
+        JUCE_SNAP_TO_ZERO(m_filterS4[lane]);
+    }
+}
+
+void PhantomVoiceBank::filterLane(int lane, int mode, int numSamples) noexcept
+{
+    mode = isPositiveAndBelow(mode, k_numFilterModes) ? mode : 0;
+
+    float* samples = getLaneData(lane, FILTER);
+    const float* gs = getLaneData(lane, FILTER_G);
+    const float* hs = getLaneData(lane, FILTER_H);
+
+    float s[4] = { m_filterS1[lane], m_filterS2[lane], m_filterS3[lane], m_filterS4[lane] };
+    const float resonance = m_filterR2[lane];
+
+    for(int i = 0; i < numSamples; i++)
+    {
+        const int idx = i * k_laneWidth;
+
+        const float g = gs[idx];
+
+        if(mode == k_ladderMode)
+        {
+            samples[idx] = evaluateLadder(samples[idx], g, hs[idx], resonance, s);
+            continue;
+        }
+
+        const float yHP = hs[idx] * (samples[idx] - s[0] * (g + resonance) - s[1]);
+
+        const float yBP = yHP * g + s[0];
+        s[0] = yHP * g + yBP;
+
+        const float yLP = yBP * g + s[1];
+        s[1] = yBP * g + yLP;
+
+        samples[idx] = mode == 0 ? yLP : (mode == 1 ? yBP : yHP);
+    }
+
+    /** NOTE: The last two states only belong to the ladder, so they start from rest when the ladder is selected. */
+    if(mode != k_ladderMode)
+    {
+        s[2] = 0.0f;
+        s[3] = 0.0f;
+    }
+
+    for(int i = 0; i < 4; i++)
+        JUCE_SNAP_TO_ZERO(s[i]);
+
+    m_filterS1[lane] = s[0];
+    m_filterS2[lane] = s[1];
+    m_filterS3[lane] = s[2];
+    m_filterS4[lane] = s[3];
+}
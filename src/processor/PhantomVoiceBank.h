@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    PhantomVoiceBank.h
+    Created: 17 Oct 2026 10:12:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_VOICE_BANK_H
+#define _PHANTOM_VOICE_BANK_H
+
+#include "JuceHeader.h"
+
+/**
+ * The structure-of-arrays state for every voice of the synth. Each voice owns one
+ * lane of the bank, and lanes are packed into groups the width of a SIMD register so
+ * that the stages with a per-sample recursion (oscillator phase accumulation and the
+ * filter) advance 4 (SSE / NEON) or 8 (AVX) voices with one instruction stream.
+ *
+ * The block data of a group is interleaved by lane (`[channel][sample][lane]`), so a
+ * single aligned load reads one sample of every voice in the group. Voices move their
+ * contiguous scratch arrays in and out of their lane with `writeLane()` / `readLane()`.
+ */
+class PhantomVoiceBank
+{
+public:
+    PhantomVoiceBank(int numVoices, int blockSize);
+    ~PhantomVoiceBank();
+
+    /** The SIMD register type used by the bank's kernels. */
+    using FloatVec = dsp::SIMDRegister<float>;
+
+    /** The SIMD register type of the per-lane bit masks. */
+    using MaskVec = FloatVec::vMaskType;
+
+    /** The number of voices (lanes) advanced together by the bank's kernels. */
+    static constexpr int k_laneWidth = (int) FloatVec::SIMDNumElements;
+
+    /**
+     * Enumerator with the block channels stored for every lane.
+     * @property PRIMARY_OSC Phase deltas for the primary oscillator, overwritten with its phases by `advancePhases()`.
+     * @property SECONDARY_OSC Phase deltas for the secondary oscillator, overwritten with its phases by `advancePhases()`.
+     * @property FILTER Input samples for the filter, overwritten with the filtered samples by `filter()`.
+     * @property FILTER_G The filter's `g` coefficient (`tan(pi * fc / fs)`) for every sample, or the one-pole
+     * gain `G` (`g / (1 + g)`) for a lane in ladder mode.
+     * @property FILTER_H The filter's `h` coefficient (`1 / (1 + R2 * g + g * g)`) for every sample, or the
+     * feedback gain (`1 / (1 + k * G^4)`) for a lane in ladder mode.
+     * @property SYNC_POSITIONS The position of a hard sync reset between a sample and the next, as the fraction
+     * of the sample period before the reset (in the range (0, 1]), or 0 if there is no reset. Written by `advancePhases()`
+     * (only if hard sync is ON).
+     * @property SYNC_PHASES The phase the secondary oscillator reaches at a reset (before it jumps back to 0).
+     * Written by `advancePhases()` (only if hard sync is ON).
+     */
+    enum BankChannel
+    {
+        PRIMARY_OSC = 0,
+        SECONDARY_OSC,
+        FILTER,
+        FILTER_G,
+        FILTER_H,
+        SYNC_POSITIONS,
+        SYNC_PHASES,
+        NUM_BANK_CHANNELS
+    };
+
+    /**
+     * Resets the oscillator phases, filter state and filter mode of a lane, called when a voice starts or is cleared.
+     * @param lane The lane to reset.
+     */
+    void resetLane(int lane) noexcept;
+
+    /**
+     * Zeroes the block data of a lane, which keeps idle voices from feeding stale data to the kernels.
+     * @param lane The lane to clear.
+     * @param numSamples The number of samples to clear.
+     */
+    void clearLane(int lane, int numSamples) noexcept;
+
+    /**
+     * Copies a contiguous block of values into a lane.
+     * @param channel The block channel to write to.
+     * @param lane The lane to write to.
+     * @param source The values to copy.
+     * @param numSamples The number of values to copy.
+     */
+    void writeLane(BankChannel channel, int lane, const float* source, int numSamples) noexcept;
+
+    /**
+     * Copies the values of a lane into a contiguous block.
+     * @param channel The block channel to read from.
+     * @param lane The lane to read from.
+     * @param dest The array to copy the values to.
+     * @param numSamples The number of values to copy.
+     */
+    void readLane(BankChannel channel, int lane, float* dest, int numSamples) const noexcept;
+
+    /**
+     * Sets the filter's resonance coefficient for a lane.
+     * @param lane The lane to update.
+     * @param coefficient The resonance coefficient of the lane's mode (see `PhantomFilter::getResonanceCoefficient()`).
+     */
+    void setFilterResonance(int lane, float coefficient) noexcept;
+
+    /**
+     * Sets the filter's mode for a lane, which is stored as one bit mask per output.
+     * @param lane The lane to update.
+     * @param mode The filter mode (0: low-pass, 1: band-pass, 2: high-pass, 3: ladder).
+     */
+    void setFilterMode(int lane, int mode) noexcept;
+
+    /**
+     * Stores the amplifier envelope level reached by a lane at the end of the last block.
+     * @param lane The lane to update.
+     * @param level The amplifier envelope level.
+     */
+    void setAmpLevel(int lane, float level) noexcept;
+
+    /**
+     * @param lane The lane to read.
+     * @returns The amplifier envelope level reached by the lane at the end of the last block.
+     */
+    float getAmpLevel(int lane) const noexcept;
+
+    /**
+     * Accumulates the oscillator phases for every lane of a group, applying hard sync of the
+     * secondary oscillator to the primary oscillator. The phases are accumulated in 32-bit
+     * fixed point, which wraps on overflow, and written out in wavetable units.
+     *
+     * The secondary oscillator is reset whenever the primary phase wraps. The reset happens at
+     * the exact (sub-sample) time of the wrap, so the secondary phase at the next sample is
+     * the time elapsed since the reset times its phase delta. The position of every reset and
+     * the phase it interrupts are written out, which the oscillator uses to band-limit the step.
+     * @param group The group of lanes to advance.
+     * @param isSynced Whether hard sync is ON.
+     * @param numSamples The number of samples to advance.
+     */
+    void advancePhases(int group, bool isSynced, int numSamples) noexcept;
+
+    /**
+     * Accumulates the oscillator phases for a single lane (scalar fallback of `advancePhases()`).
+     * @param lane The lane to advance.
+     * @param isSynced Whether hard sync is ON.
+     * @param numSamples The number of samples to advance.
+     */
+    void advanceLanePhases(int lane, bool isSynced, int numSamples) noexcept;
+
+    /**
+     * Runs the topology-preserving-transform state-variable filter for every lane of a group,
+     * each lane with its own coefficients and mode. Every lane computes all three outputs and
+     * keeps the one of its mode by blending them with its bit masks, so lanes with different
+     * modes share one instruction stream.
+     *
+     * Lanes in ladder mode run the 4-pole zero-delay-feedback ladder instead, which is only
+     * computed for the groups holding such a lane (and blended in the same way when the group
+     * mixes both filters).
+     * @param group The group of lanes to filter.
+     * @param numSamples The number of samples to filter.
+     */
+    void filter(int group, int numSamples) noexcept;
+
+    /**
+     * Runs the filter for a single lane (scalar fallback of `filter()`).
+     * @param lane The lane to filter.
+     * @param mode The filter mode (0: low-pass, 1: band-pass, 2: high-pass, 3: ladder).
+     * @param numSamples The number of samples to filter.
+     */
+    void filterLane(int lane, int mode, int numSamples) noexcept;
+
+    /** @returns The number of lane groups in the bank. */
+    int getNumGroups() const noexcept { return m_numGroups; };
+
+    /** @returns The maximum number of samples the bank can hold per lane. */
+    int getBlockSize() const noexcept { return m_blockSize; };
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomVoiceBank)
+
+    /**
+     * @param group The group of lanes.
+     * @param channel The block channel.
+     * @returns The SIMD-aligned, lane-interleaved block data of a group's channel.
+     */
+    float* getGroupData(int group, int channel) const noexcept;
+
+    /**
+     * @param lane The lane.
+     * @param channel The block channel.
+     * @returns The pointer to the first sample of a lane's channel (with a stride of `k_laneWidth`).
+     */
+    float* getLaneData(int lane, int channel) const noexcept;
+
+    /** The memory holding the per-lane state and block data (with room for alignment). */
+    HeapBlock<float> m_memory;
+
+    /** The SIMD-aligned start of the lane-interleaved block data. */
+    float* m_blockData = nullptr;
+
+    /** The memory holding the per-lane oscillator phases. */
+    HeapBlock<uint32> m_phaseMemory;
+
+    /** The per-lane fixed-point phase of the primary oscillator (a full cycle is 2^32). */
+    uint32* m_primaryPhases = nullptr;
+
+    /** The per-lane fixed-point phase of the secondary oscillator (a full cycle is 2^32). */
+    uint32* m_secondaryPhases = nullptr;
+
+    /** The per-lane first integrator state of the filter. */
+    float* m_filterS1 = nullptr;
+
+    /** The per-lane second integrator state of the filter. */
+    float* m_filterS2 = nullptr;
+
+    /** The per-lane third integrator state of the filter (ladder only). */
+    float* m_filterS3 = nullptr;
+
+    /** The per-lane fourth integrator state of the filter (ladder only). */
+    float* m_filterS4 = nullptr;
+
+    /** The per-lane resonance coefficient of the filter (`R2 = 1 / Q`, or the ladder's feedback `k`). */
+    float* m_filterR2 = nullptr;
+
+    /** The memory holding the per-lane filter mode masks (with room for alignment). */
+    HeapBlock<uint32> m_maskMemory;
+
+    /** The SIMD-aligned per-lane filter mode masks, one array per filter output (`[mode][lane]`). */
+    uint32* m_filterModeMasks = nullptr;
+
+    /** The per-lane level of the amplifier envelope. */
+    float* m_ampLevels = nullptr;
+
+    /** The number of lanes, rounded up to a whole number of groups. */
+    int m_numLanes = 0;
+
+    /** The number of lane groups. */
+    int m_numGroups = 0;
+
+    /** The maximum number of samples held per lane. */
+    int m_blockSize = 0;
+};
+
+#endif
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    PhantomInterpolator.h
+    Created: 17 Oct 2026 18:05:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_INTERPOLATOR_H
+#define _PHANTOM_INTERPOLATOR_H
+
+#include "JuceHeader.h"
+
+/**
+ * Runs a modulation source at control rate, computing a control point every `interval`
+ * samples and linearly interpolating between them. The output lags the source by one
+ * control interval, which is inaudible for modulation.
+ */
+class PhantomInterpolator
+{
+public:
+    PhantomInterpolator() { }
+    ~PhantomInterpolator() { }
+
+    /**
+     * Sets the number of samples between control points, restarting the interpolation.
+     * @param interval The number of samples between control points (1 for audio rate).
+     */
+    void setInterval(int interval) noexcept
+    {
+        m_interval = jmax(1, interval);
+        m_numUntilControl = 0;
+    }
+
+    /** @returns The number of samples between control points. */
+    int getInterval() const noexcept { return m_interval; };
+
+    /**
+     * Jumps to a value, with the next control point computed on the next sample.
+     * @param value The value to jump to.
+     */
+    void reset(float value) noexcept
+    {
+        m_value = value;
+        m_target = value;
+        m_increment = 0.0f;
+        m_numUntilControl = 0;
+    }
+
+    /**
+     * Writes a block of interpolated values.
+     * @param dest The array to write the values to.
+     * @param numSamples The number of values to write.
+     * @param nextControlValue Called for each control point, returning the source value one interval later.
+     */
+    template <typename ControlFunction>
+    void process(float* dest, int numSamples, ControlFunction&& nextControlValue) noexcept
+    {
+        int sampleIdx = 0;
+
+        while(sampleIdx < numSamples)
+        {
+            if(m_numUntilControl == 0)
+            {
+                m_target = nextControlValue();
+                m_increment = (m_target - m_value) / (float) m_interval;
+                m_numUntilControl = m_interval;
+            }
+
+            const int numToWrite = jmin(numSamples - sampleIdx, m_numUntilControl);
+
+            float value = m_value;
+            for(int i = 0; i < numToWrite; i++)
+            {
+                value += m_increment;
+                dest[sampleIdx + i] = value;
+            }
+
+            m_numUntilControl -= numToWrite;
+            m_value = m_numUntilControl == 0 ? m_target : value;
+            sampleIdx += numToWrite;
+        }
+    }
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomInterpolator)
+
+    /** The number of samples between control points. */
+    int m_interval = 1;
+
+    /** The number of samples left until the next control point. */
+    int m_numUntilControl = 0;
+
+    /** The last value written. */
+    float m_value = 0.0f;
+
+    /** The next control point. */
+    float m_target = 0.0f;
+
+    /** The value added every sample until the next control point. */
+    float m_increment = 0.0f;
+};
+
+#endif
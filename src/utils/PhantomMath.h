@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    PhantomMath.h
+    Created: 17 Oct 2026 20:10:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_MATH_H
+#define _PHANTOM_MATH_H
+
+#include "JuceHeader.h"
+
+/**
+ * Fast approximations of the math used on the audio thread for every voice and sample.
+ *
+ * `exp2()` splits its argument into an integer and a fraction in [-0.5, 0.5], builds the
+ * power of two for the integer in the float's exponent bits, and approximates the fraction
+ * with a degree 5 polynomial. Its relative error is below 5e-6 over the whole range (3.3e-6
+ * measured against `std::exp2` of the same float argument; rounding the argument to a float
+ * adds up to another 2.6e-6 at the ends of the range), which keeps `midiNoteToFrequency()`
+ * within 0.007 cents over MIDI notes 0 to 127.
+ *
+ * `exp()` stays below 8e-6 relative error and `log()` below 1e-5 absolute error. `tanh()` is
+ * built on `exp()` and `atan()` is a minimax polynomial on [-1, 1]; they stay below 2e-6 and
+ * 5e-7 absolute error. These bounds are checked by `tests/PhantomMathTests.cpp`. The polynomial is
+ * accurate enough that the antiderivatives built on it can be differenced (as done by the
+ * anti-aliased waveshapers) without its ripple showing through.
+ */
+namespace PhantomMath
+{
+    /**
+     * Approximates `2^x`.
+     * @param x The exponent, which is clamped to [-126, 126].
+     * @returns The power of two.
+     */
+    static inline float exp2(float x) noexcept
+    {
+        x = jlimit(-126.0f, 126.0f, x);
+
+        /** NOTE: Truncating a positive value floors it, which avoids a call to `floor()`. */
+        const int exponent = (int) (x + 127.5f) - 127;
+        const float fraction = x - (float) exponent;
+
+        const float polynomial = 1.0f + fraction * (0.693147181f + fraction * (0.240226507f + fraction * (0.0555041087f + fraction * (0.00961812911f + fraction * 0.00133335581f))));
+
+        const int32 bits = (exponent + 127) << 23;
+        float power;
+        std::memcpy(&power, &bits, sizeof(float));
+
+        return polynomial * power;
+    }
+
+    /**
+     * Approximates `2^x` for a block of values.
+     * NOTE: The loop has no branches or carried state, so it vectorizes.
+     * @param dest The array to write the powers of two to (may be the same array as `exponents`).
+     * @param exponents The exponents, which are clamped to [-126, 126].
+     * @param numSamples The number of values.
+     */
+    static inline void exp2(float* dest, const float* exponents, int numSamples) noexcept
+    {
+        for(int i = 0; i < numSamples; i++)
+            dest[i] = exp2(exponents[i]);
+    }
+
+    /**
+     * Approximates `e^x` with `exp2()`.
+     * @param x The exponent, which is clamped to about [-87, 87].
+     * @returns The power of e.
+     */
+    static inline float exp(float x) noexcept
+    {
+        return exp2(x * 1.44269504f);
+    }
+
+    /**
+     * Approximates `ln(x)`. The mantissa is centered on 1 (in [sqrt(1/2), sqrt(2)]) and its logarithm
+     * is approximated by the series `2 * atanh(t)` with `t = (m - 1) / (m + 1)`, whose terms fall off
+     * quickly as `|t| <= 0.172`.
+     * @param x The value, which must be positive and normal.
+     * @returns The natural logarithm of the value.
+     */
+    static inline float log(float x) noexcept
+    {
+        int32 bits;
+        std::memcpy(&bits, &x, sizeof(float));
+
+        int exponent = ((bits >> 23) & 0xff) - 127;
+        bits = (bits & 0x007fffff) | 0x3f800000;
+
+        float mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(float));
+
+        const bool isAboveSqrt2 = mantissa > 1.41421356f;
+        mantissa = isAboveSqrt2 ? mantissa * 0.5f : mantissa;
+        exponent += isAboveSqrt2 ? 1 : 0;
+
+        const float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+        const float t2 = t * t;
+        const float series = 2.0f * t * (1.0f + t2 * (0.333333333f + t2 * (0.2f + t2 * (0.142857143f + t2 * 0.111111111f))));
+
+        return series + (float) exponent * 0.693147181f;
+    }
+
+    /**
+     * Approximates `tanh(x)` from `exp()`, which saturates to +/- 1 for large values.
+     * @param x The value to saturate.
+     * @returns The hyperbolic tangent of the value.
+     */
+    static inline float tanh(float x) noexcept
+    {
+        const float e = exp(2.0f * x);
+        return (e - 1.0f) / (e + 1.0f);
+    }
+
+    /**
+     * Approximates `atan(x)` with a degree 13 odd polynomial.
+     * @param x The value, which must be in the range [-1, 1].
+     * @returns The arctangent of the value (radians).
+     */
+    static inline float atan(float x) noexcept
+    {
+        const float x2 = x * x;
+        return x * (0.999996111f + x2 * (-0.333173664f + x2 * (0.198078019f + x2 * (-0.132332929f + x2 * (0.0796228119f + x2 * (-0.0336035018f + x2 * 0.00681156308f))))));
+    }
+
+    /**
+     * Converts a (fractional) MIDI pitch to frequency.
+     * @param midiNote The MIDI pitch, where 69 is A4 (440 Hz).
+     * @returns The frequency (Hz).
+     */
+    static inline float midiNoteToFrequency(float midiNote) noexcept
+    {
+        return 440.0f * exp2((midiNote - 69.0f) * (1.0f / 12.0f));
+    }
+}
+
+#endif
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    PhantomParameters.h
+    Created: 17 Oct 2026 16:20:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_PARAMETERS_H
+#define _PHANTOM_PARAMETERS_H
+
+/**
+ * The plain parameter values for each DSP stage, read from the `AudioProcessorValueTreeState`
+ * once per block by the `PhantomParameterSnapshot` and handed down to the stages. Every stage
+ * sees the same values for a whole block and never touches an atomic while rendering.
+ * NOTE: Values are kept as floats (the same as the atomic parameters) and cast by the stages.
+ */
+
+/** The parameter values for the amplifier. */
+struct PhantomAmplifierParameters
+{
+    float level = 0.0f;
+};
+
+/** The parameter values for a phasor. */
+struct PhantomPhasorParameters
+{
+    float shape = 0.0f;
+    float egInt = 0.0f;
+    float lfoInt = 0.0f;
+};
+
+/** The parameter values for an oscillator (and its phasor). */
+struct PhantomOscillatorParameters
+{
+    float range = 0.0f;
+    float coarseTune = 0.0f;
+    float fineTune = 0.0f;
+    float shapeInt = 0.0f;
+    float modDepth = 0.0f;
+    float modSource = 0.0f;
+
+    PhantomPhasorParameters phasor;
+};
+
+/** The parameter values for the mixer. */
+struct PhantomMixerParameters
+{
+    float oscBalance = 0.0f;
+    float ampGain = 0.0f;
+    float ringMod = 0.0f;
+    float noise = 0.0f;
+};
+
+/** The parameter values for the filter. */
+struct PhantomFilterParameters
+{
+    float cutoff = 0.0f;
+    float resonance = 1.0f;
+    float drive = 0.0f;
+    float mode = 0.0f;
+    float egModDepth = 0.0f;
+    float lfoModDepth = 0.0f;
+};
+
+/** The parameter values for an LFO. */
+struct PhantomLFOParameters
+{
+    float rate = 0.0f;
+    float shape = 0.0f;
+    float mode = 0.0f;
+};
+
+/** The parameter values for an envelope generator. */
+struct PhantomEnvelopeParameters
+{
+    float attack = 0.0f;
+    float decay = 0.0f;
+    float sustain = 0.0f;
+    float release = 0.0f;
+};
+
+/** The parameter values for every stage of the synth for one block. */
+struct PhantomParameters
+{
+    PhantomAmplifierParameters amp;
+
+    float polyphony = 1.0f;
+    float voiceSteal = 0.0f;
+    float oscSync = 0.0f;
+
+    /** The engine settings that are applied live (the others re-prepare the synth). */
+    float modRate = 0.0f;
+    float ampEgAudioRate = 0.0f;
+    float oscInterpolation = 0.0f;
+
+    /** The oscillators (and phasors), indexed from 0. */
+    PhantomOscillatorParameters osc[2];
+
+    PhantomMixerParameters mixer;
+
+    PhantomFilterParameters filter;
+
+    /** The LFOs, indexed from 0. */
+    PhantomLFOParameters lfo[2];
+
+    /** The envelope generators, indexed by `EnvelopeType`. */
+    PhantomEnvelopeParameters eg[4];
+};
+
+/**
+ * The smoothed values of a continuous parameter for the samples being rendered, written by a
+ * `PhantomSmoother` before the stages that read it are run.
+ * NOTE: `values` always holds the samples being rendered, but while the parameter isn't moving
+ * every value is the same and stages can use `value` instead.
+ */
+struct PhantomRamp
+{
+    /** The smoothed value of each sample. */
+    const float* values = nullptr;
+
+    /** The smoothed value of the last sample. */
+    float value = 0.0f;
+
+    /** Whether the values change within the samples being rendered. */
+    bool isSmoothing = false;
+};
+
+/** The smoothed parameters of a phasor. */
+struct PhantomPhasorRamps
+{
+    PhantomRamp egInt;
+    PhantomRamp lfoInt;
+};
+
+/** The smoothed parameters of an oscillator (and its phasor). */
+struct PhantomOscillatorRamps
+{
+    PhantomRamp shapeInt;
+    PhantomRamp modDepth;
+
+    PhantomPhasorRamps phasor;
+};
+
+/** The smoothed parameters of the mixer. */
+struct PhantomMixerRamps
+{
+    PhantomRamp oscBalance;
+    PhantomRamp ampGain;
+    PhantomRamp ringMod;
+    PhantomRamp noise;
+};
+
+/** The smoothed parameters of the filter. */
+struct PhantomFilterRamps
+{
+    PhantomRamp cutoff;
+    PhantomRamp resonance;
+    PhantomRamp drive;
+    PhantomRamp egModDepth;
+    PhantomRamp lfoModDepth;
+};
+
+/** The smoothed parameters of every voice stage, shared (read-only) by every voice. */
+struct PhantomRamps
+{
+    /** The oscillators (and phasors), indexed from 0. */
+    PhantomOscillatorRamps osc[2];
+
+    PhantomMixerRamps mixer;
+
+    PhantomFilterRamps filter;
+
+    /** The envelope generator sustain levels (in dB), indexed by `EnvelopeType`. */
+    PhantomRamp egSustain[4];
+};
+
+/**
+ * The values of the global (free-running) LFOs for the samples being rendered, which the synth
+ * computes once per block and every voice reads (read-only) instead of running its own LFOs.
+ */
+struct PhantomGlobalModulation
+{
+    /** The values of each LFO in global mode, indexed from 0. */
+    const float* lfo[2] = { nullptr, nullptr };
+};
+
+#endif
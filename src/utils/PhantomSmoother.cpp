@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    PhantomSmoother.cpp
+    Created: 17 Oct 2026 17:10:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "PhantomSmoother.h"
+
+PhantomSmoother::PhantomSmoother()
+{
+
+}
+
+PhantomSmoother::~PhantomSmoother()
+{
+    m_parameters.clear();
+}
+
+void PhantomSmoother::add(const float& target, PhantomRamp& ramp, float rampTime, Curve curve)
+{
+    m_parameters.add({ &target, &ramp, rampTime, curve, nullptr, target, target, 0.0f, false, 0 });
+}
+
+void PhantomSmoother::prepare(float sampleRate, int maxNumSamples)
+{
+    m_sampleRate = sampleRate;
+    m_maxNumSamples = jmax(1, maxNumSamples);
+
+    m_rampBuffer.setSize(jmax(1, m_parameters.size()), m_maxNumSamples);
+
+    for(int i = 0; i < m_parameters.size(); i++)
+    {
+        Parameter& parameter = m_parameters.getReference(i);
+
+        parameter.values = m_rampBuffer.getWritePointer(i);
+        parameter.current = *parameter.target;
+        parameter.end = parameter.current;
+        parameter.numRemaining = 0;
+
+        FloatVectorOperations::fill(parameter.values, parameter.current, m_maxNumSamples);
+
+        parameter.ramp->values = parameter.values;
+        parameter.ramp->value = parameter.current;
+        parameter.ramp->isSmoothing = false;
+    }
+}
+
+void PhantomSmoother::process(int numSamples) noexcept
+{
+    jassert(numSamples <= m_maxNumSamples);
+
+    for(Parameter& parameter : m_parameters)
+    {
+        const float target = *parameter.target;
+        if(target != parameter.end)
+            startRamp(parameter, target);
+
+        PhantomRamp& ramp = *parameter.ramp;
+
+        /** NOTE: The ramp buffer was filled with the value when the last ramp ended. */
+        if(parameter.numRemaining == 0)
+        {
+            ramp.isSmoothing = false;
+            continue;
+        }
+
+        float* values = parameter.values;
+        const int numToRamp = jmin(numSamples, parameter.numRemaining);
+
+        float current = parameter.current;
+        const float step = parameter.step;
+
+        if(parameter.isMultiplying)
+        {
+            for(int i = 0; i < numToRamp; i++)
+            {
+                current *= step;
+                values[i] = current;
+            }
+        }
+        else
+        {
+            for(int i = 0; i < numToRamp; i++)
+            {
+                current += step;
+                values[i] = current;
+            }
+        }
+
+        parameter.numRemaining -= numToRamp;
+
+        /** NOTE: Snaps to the end of the ramp and fills the rest of the buffer, which stays valid until the next ramp. */
+        if(parameter.numRemaining == 0)
+        {
+            current = parameter.end;
+            values[numToRamp - 1] = current;
+
+            FloatVectorOperations::fill(values + numToRamp, current, m_maxNumSamples - numToRamp);
+        }
+
+        parameter.current = current;
+
+        ramp.value = current;
+        ramp.isSmoothing = true;
+    }
+}
+
+void PhantomSmoother::startRamp(Parameter& parameter, float target) noexcept
+{
+    parameter.end = target;
+    parameter.numRemaining = roundToInt(parameter.rampTime * m_sampleRate);
+
+    if(parameter.numRemaining <= 0)
+    {
+        parameter.numRemaining = 0;
+        parameter.current = target;
+
+        FloatVectorOperations::fill(parameter.values, target, m_maxNumSamples);
+        parameter.ramp->value = target;
+        return;
+    }
+
+    const float numRampSamples = (float) parameter.numRemaining;
+
+    parameter.isMultiplying = parameter.curve == MULTIPLICATIVE && parameter.current > 0.0f && target > 0.0f;
+
+    if(parameter.isMultiplying)
+        parameter.step = std::exp((std::log(target) - std::log(parameter.current)) / numRampSamples);
+    else
+        parameter.step = (target - parameter.current) / numRampSamples;
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    PhantomSmoother.h
+    Created: 17 Oct 2026 17:10:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#ifndef _PHANTOM_SMOOTHER_H
+#define _PHANTOM_SMOOTHER_H
+
+#include "JuceHeader.h"
+
+#include "PhantomParameters.h"
+
+/**
+ * Smooths continuous parameters towards their values in the parameter snapshot, writing a
+ * ramp of values for the samples being rendered that the stages read as a vector. Each
+ * parameter has its own ramp time and curve, and parameters that aren't moving cost nothing
+ * more than a comparison, as their ramp buffer already holds their value.
+ *
+ * CAUTION: The smoother isn't thread-safe, `process()` must be called from the audio thread
+ * before the stages reading the ramps are run.
+ */
+class PhantomSmoother
+{
+public:
+    PhantomSmoother();
+    ~PhantomSmoother();
+
+    /**
+     * Enumerator with the curves a parameter is smoothed along.
+     * @property LINEAR Adds the same step every sample, for parameters like intensities and levels in dB.
+     * @property MULTIPLICATIVE Multiplies by the same factor every sample, for parameters heard logarithmically
+     * like frequencies and gains. Falls back to `LINEAR` when either end of the ramp is not positive.
+     */
+    enum Curve
+    {
+        LINEAR = 0,
+        MULTIPLICATIVE
+    };
+
+    /**
+     * Adds a parameter to smooth, which takes effect on the next call to `prepare()`.
+     * @param target The parameter value to smooth towards (read on every call to `process()`).
+     * @param ramp The ramp to write the smoothed values to.
+     * @param rampTime The time (in seconds) it takes to reach a new value.
+     * @param curve The curve to smooth the parameter along.
+     */
+    void add(const float& target, PhantomRamp& ramp, float rampTime, Curve curve);
+
+    /**
+     * Allocates the ramp buffers and jumps every parameter to its target.
+     * @param sampleRate The sample rate to use in converting ramp times to samples.
+     * @param maxNumSamples The largest number of samples passed to `process()`.
+     */
+    void prepare(float sampleRate, int maxNumSamples);
+
+    /**
+     * Writes the ramps for the next samples to render, starting a new ramp for every parameter
+     * whose target changed.
+     * @param numSamples The number of samples to render (no more than `getMaxNumSamples()`).
+     */
+    void process(int numSamples) noexcept;
+
+    /**
+     * @returns The largest number of samples that can be passed to `process()`.
+     */
+    int getMaxNumSamples() const noexcept { return m_maxNumSamples; };
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PhantomSmoother)
+
+    /**
+     * A smoothed parameter, its metadata and its progress towards the target.
+     */
+    struct Parameter
+    {
+        const float* target;
+        PhantomRamp* ramp;
+        float rampTime;
+        Curve curve;
+
+        /** The ramp buffer of the parameter (a channel of `m_rampBuffer`). */
+        float* values;
+
+        /** The value of the last sample written. */
+        float current;
+
+        /** The value being ramped to. */
+        float end;
+
+        /** The step added to (or factor multiplied with) the current value every sample. */
+        float step;
+
+        /** Whether the current ramp is multiplicative. */
+        bool isMultiplying;
+
+        /** The number of samples left in the current ramp. */
+        int numRemaining;
+    };
+
+    /**
+     * Starts a ramp from the current value of a parameter towards a new target.
+     * @param parameter The parameter to start the ramp for.
+     * @param target The new target of the parameter.
+     */
+    void startRamp(Parameter& parameter, float target) noexcept;
+
+    /** The smoothed parameters. */
+    Array<Parameter> m_parameters;
+
+    /** The ramp buffers, one channel for each parameter. */
+    AudioBuffer<float> m_rampBuffer;
+
+    /** The sample rate, useful for converting ramp times to samples. */
+    float m_sampleRate = 44100.0f;
+
+    /** The largest number of samples that can be processed at once. */
+    int m_maxNumSamples = 0;
+};
+
+#endif
@@ -26,6 +26,36 @@ namespace Consts
     constexpr char *_LEVEL_PARAM_NAME = "Level";
     constexpr float _LEVEL_DEFAULT_VAL = 0.0f;
 
+    // VOICES
+
+    constexpr char *_POLYPHONY_PARAM_ID = "polyphony";
+    constexpr char *_POLYPHONY_PARAM_NAME = "Polyphony";
+    constexpr float _POLYPHONY_DEFAULT_VAL = 16.0f;
+
+    constexpr char *_VOICE_STEAL_PARAM_ID = "voiceSteal";
+    constexpr char *_VOICE_STEAL_PARAM_NAME = "Voice Steal";
+    constexpr float _VOICE_STEAL_DEFAULT_VAL = 2.0f;
+
+    constexpr char *_OVERSAMPLING_PARAM_ID = "oversampling";
+    constexpr char *_OVERSAMPLING_PARAM_NAME = "Oversampling";
+    constexpr float _OVERSAMPLING_DEFAULT_VAL = 0.0f;
+
+    constexpr char *_MULTI_CORE_PARAM_ID = "multiCore";
+    constexpr char *_MULTI_CORE_PARAM_NAME = "Multi-Core Rendering";
+    constexpr float _MULTI_CORE_DEFAULT_VAL = 0.0f;
+
+    constexpr char *_MOD_RATE_PARAM_ID = "modRate";
+    constexpr char *_MOD_RATE_PARAM_NAME = "Modulation Rate";
+    constexpr float _MOD_RATE_DEFAULT_VAL = 2.0f;
+
+    constexpr char *_AMP_EG_AUDIO_RATE_PARAM_ID = "ampEgAudioRate";
+    constexpr char *_AMP_EG_AUDIO_RATE_PARAM_NAME = "Amp EG Audio Rate";
+    constexpr float _AMP_EG_AUDIO_RATE_DEFAULT_VAL = 1.0f;
+
+    constexpr char *_OSC_INTERPOLATION_PARAM_ID = "oscInterpolation";
+    constexpr char *_OSC_INTERPOLATION_PARAM_NAME = "Osc Interpolation";
+    constexpr float _OSC_INTERPOLATION_DEFAULT_VAL = 1.0f;
+
     // OSCILLATORs
 
     constexpr char *_OSC_SYNC_PARAM_ID = "oscSync";
@@ -133,12 +163,18 @@ namespace Consts
     constexpr char *_LFO_01_SHAPE_PARAM_ID = "lfo01Shape";
     constexpr char *_LFO_01_SHAPE_PARAM_NAME = "LFO 1 Shape";
     constexpr float _LFO_01_SHAPE_DEFAULT_VAL = 0.0f;
+    constexpr char *_LFO_01_MODE_PARAM_ID = "lfo01Mode";
+    constexpr char *_LFO_01_MODE_PARAM_NAME = "LFO 1 Mode";
+    constexpr float _LFO_01_MODE_DEFAULT_VAL = 0.0f;
     constexpr char *_LFO_02_RATE_PARAM_ID = "lfo02Rate";
     constexpr char *_LFO_02_RATE_PARAM_NAME = "LFO 2 Rate";
     constexpr float _LFO_02_RATE_DEFAULT_VAL = 20.0f;
     constexpr char *_LFO_02_SHAPE_PARAM_ID = "lfo02Shape";
     constexpr char *_LFO_02_SHAPE_PARAM_NAME = "LFO 2 Shape";
     constexpr float _LFO_02_SHAPE_DEFAULT_VAL = 0.0f;
+    constexpr char *_LFO_02_MODE_PARAM_ID = "lfo02Mode";
+    constexpr char *_LFO_02_MODE_PARAM_NAME = "LFO 2 Mode";
+    constexpr float _LFO_02_MODE_DEFAULT_VAL = 0.0f;
 
     // EGs
 
@@ -194,7 +230,13 @@ namespace Consts
     constexpr char *_MOD_EG_REL_PARAM_NAME = "Mod EG Release";
     constexpr float _MOD_EG_REL_DEFAULT_VAL = 0.2f;
 
-    constexpr int _WAVETABLE_SIZE = 1 << 11;
+    constexpr int _MAX_POLYPHONY = 64;
+    constexpr float _VOICE_STEAL_FADE_TIME = 0.005f;
+    constexpr float _PARAM_SMOOTHING_TIME = 0.02f;
+    constexpr int _MOD_CONTROL_INTERVAL = 16;
+
+    constexpr int _WAVETABLE_BITS = 11;
+    constexpr int _WAVETABLE_SIZE = 1 << _WAVETABLE_BITS;
 
     const Colour _WHITE_COLOUR = Colour::fromRGBA(233, 251, 245, 255);
     const Colour _PRIMARY_COLOUR = Colour::fromRGBA(38, 217, 157, 255);
@@ -231,4 +273,25 @@ static float calculateSkewFactor(float start, float end, float center)
     return std::log(0.5f) / std::log((center - start) / (end - start));
 }
 
+/**
+ * Converts a phase (or phase delta) in wavetable units to a 32-bit fixed-point phase, where
+ * a full cycle is 2^32, so accumulated phases wrap for free on overflow.
+ * @param phase The phase in the range [0, _WAVETABLE_SIZE), where larger values wrap.
+ * @returns The fixed-point phase.
+ */
+static inline uint32 phaseToFixed(float phase) noexcept
+{
+    return (uint32) (int64) (phase * (4294967296.0f / (float) Consts::_WAVETABLE_SIZE));
+}
+
+/**
+ * Converts a 32-bit fixed-point phase back to wavetable units.
+ * @param phase The fixed-point phase.
+ * @returns The phase in the range [0, _WAVETABLE_SIZE).
+ */
+static inline float fixedToPhase(uint32 phase) noexcept
+{
+    return (float) (phase >> 8) * ((float) Consts::_WAVETABLE_SIZE / 16777216.0f);
+}
+
 #endif
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    PhantomMathTests.cpp
+    Created: 17 Oct 2026 21:40:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+
+#include "../src/utils/PhantomMath.h"
+
+/**
+ * Bounds the error of the `PhantomMath` approximations against the standard library
+ * (evaluated in double precision at the same float arguments).
+ */
+class PhantomMathTests : public UnitTest
+{
+public:
+    PhantomMathTests() : UnitTest("PhantomMath", "Phantom") {}
+
+    void runTest() override
+    {
+        beginTest("exp2 relative error");
+        {
+            double maxError = 0.0;
+
+            for(double x = -126.0; x <= 126.0; x += 1.0 / 4096.0)
+            {
+                const float xf = (float) x;
+                maxError = jmax(maxError, std::abs(PhantomMath::exp2(xf) / std::exp2((double) xf) - 1.0));
+            }
+
+            logMessage("Max relative error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxExp2Error, "exp2 relative error");
+        }
+
+        beginTest("midiNoteToFrequency error in cents");
+        {
+            double maxCents = 0.0;
+
+            /** NOTE: Fractional notes are swept as well, since pitch modulation moves between them. */
+            for(int i = 0; i <= 127 * 1024; i++)
+            {
+                const float note = (float) i / 1024.0f;
+                const double frequency = 440.0 * std::exp2(((double) note - 69.0) / 12.0);
+
+                maxCents = jmax(maxCents, std::abs(1200.0 * std::log2(PhantomMath::midiNoteToFrequency(note) / frequency)));
+            }
+
+            logMessage("Max error: " + String(maxCents, 3, true) + " cents");
+            expectLessThan(maxCents, k_maxCentsError, "midiNoteToFrequency error in cents");
+        }
+
+        beginTest("exp relative error");
+        {
+            double maxError = 0.0;
+
+            for(double x = -87.0; x <= 87.0; x += 1.0 / 1024.0)
+            {
+                const float xf = (float) x;
+                maxError = jmax(maxError, std::abs(PhantomMath::exp(xf) / std::exp((double) xf) - 1.0));
+            }
+
+            logMessage("Max relative error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxExpError, "exp relative error");
+        }
+
+        beginTest("log absolute error");
+        {
+            double maxError = 0.0;
+
+            /** NOTE: The values are spread evenly in their logarithm, which covers every exponent of a normal float. */
+            for(double l = -87.0; l <= 88.0; l += 1.0 / 1024.0)
+            {
+                const float xf = (float) std::exp(l);
+                maxError = jmax(maxError, std::abs(PhantomMath::log(xf) - std::log((double) xf)));
+            }
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxLogError, "log absolute error");
+        }
+
+        beginTest("tanh absolute error");
+        {
+            double maxError = 0.0;
+
+            for(double x = -20.0; x <= 20.0; x += 1.0 / 16384.0)
+            {
+                const float xf = (float) x;
+                maxError = jmax(maxError, std::abs(PhantomMath::tanh(xf) - std::tanh((double) xf)));
+            }
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxTanhError, "tanh absolute error");
+        }
+
+        beginTest("atan absolute error");
+        {
+            double maxError = 0.0;
+
+            for(double x = -1.0; x <= 1.0; x += 1.0 / 65536.0)
+            {
+                const float xf = (float) x;
+                maxError = jmax(maxError, std::abs(PhantomMath::atan(xf) - std::atan((double) xf)));
+            }
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxAtanError, "atan absolute error");
+        }
+    }
+
+private:
+    /** The bounds of the errors, a little above the measured errors (see `PhantomMath.h`). */
+    const double k_maxExp2Error = 5e-6;
+    const double k_maxCentsError = 0.007;
+    const double k_maxExpError = 8e-6;
+    const double k_maxLogError = 1e-5;
+    const double k_maxTanhError = 2e-6;
+    const double k_maxAtanError = 5e-7;
+};
+
+static PhantomMathTests phantomMathTests;
@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    PhantomTests.cpp
+    Created: 17 Oct 2026 21:40:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+
+/**
+ * Runs every unit test in the "Phantom" category (each test registers itself when its
+ * file is linked in), returning a non-zero exit code if any of them fails.
+ */
+int main(int argc, char* argv[])
+{
+    ignoreUnused(argc, argv);
+
+    UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("Phantom");
+
+    int numFailures = 0;
+
+    for(int i = 0; i < runner.getNumResults(); i++)
+        numFailures += runner.getResult(i)->failures;
+
+    return numFailures > 0 ? 1 : 0;
+}
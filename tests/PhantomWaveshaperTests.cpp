@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    PhantomWaveshaperTests.cpp
+    Created: 17 Oct 2026 22:30:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+
+#include "../src/effects/PhantomWaveshaper.h"
+
+/**
+ * Bounds the error of the waveshapers, and of the segment averages of their anti-aliased
+ * versions, against closed forms evaluated in double precision with the standard library.
+ */
+class PhantomWaveshaperTests : public UnitTest
+{
+public:
+    PhantomWaveshaperTests() : UnitTest("PhantomWaveshaper", "Phantom") {}
+
+    void runTest() override
+    {
+        beginTest("atsr absolute error");
+        {
+            double maxError = 0.0;
+
+            for(double x = -2.0; x <= 2.0; x += 1.0 / 16384.0)
+            {
+                const float xf = (float) x;
+                maxError = jmax(maxError, std::abs(m_waveshaper.atsr(xf) - atsr((double) xf)));
+            }
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxAtsrError, "atsr absolute error");
+        }
+
+        beginTest("htan absolute error");
+        {
+            double maxError = 0.0;
+
+            for(double k = 0.0; k <= 1.0; k += 1.0 / 16.0)
+                for(double x = -2.0; x <= 2.0; x += 1.0 / 4096.0)
+                {
+                    const float xf = (float) x;
+                    maxError = jmax(maxError, std::abs(m_waveshaper.htan((float) k, xf) - htan(k, (double) xf)));
+                }
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxShaperError, "htan absolute error");
+        }
+
+        /**
+         * NOTE: Each segment is shaped as a block of one sample continuing from its start, so
+         * the output is the average of the shaper over the segment. The segment widths run from
+         * well below the ill-conditioned tolerance (where the midpoint is used) to a full unit,
+         * so both branches and the switch between them are covered.
+         */
+        beginTest("atsrADAA absolute error");
+        {
+            double maxError = 0.0;
+            const float mix = 1.0f;
+
+            forEachSegment([&](float x0, float x1)
+            {
+                float sample = x1;
+                m_waveshaper.reset(x0);
+                m_waveshaper.atsrADAA(&sample, &mix, 1);
+
+                maxError = jmax(maxError, std::abs(sample - average(x0, x1, [](double x) { return atsrAntiderivative(x); }, [](double x) { return atsr(x); })));
+            });
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxADAAError, "atsrADAA absolute error");
+        }
+
+        beginTest("htanADAA absolute error");
+        {
+            double maxError = 0.0;
+
+            for(double k = 0.0; k <= 1.0; k += 1.0 / 8.0)
+            {
+                const float drive = (float) k;
+
+                forEachSegment([&](float x0, float x1)
+                {
+                    float sample = x1;
+                    m_waveshaper.reset(x0);
+                    m_waveshaper.htanADAA(&sample, &drive, 1);
+
+                    /** NOTE: The drive blends the shaped sample with the dry one as well. */
+                    const double shape = average(x0, x1, [&](double x) { return htanAntiderivative(drive, x); }, [&](double x) { return htan(drive, x); });
+                    maxError = jmax(maxError, std::abs(sample - (x1 + drive * (shape - x1))));
+                });
+            }
+
+            logMessage("Max absolute error: " + String(maxError, 3, true));
+            expectLessThan(maxError, k_maxADAAError, "htanADAA absolute error");
+        }
+    }
+
+private:
+    /**
+     * Calls a function for segments starting all over [-2, 2], with widths spread evenly in
+     * their logarithm between 1e-6 and 1 (in both directions).
+     * @param function The function to call with the start and end of each segment.
+     */
+    template <typename Function>
+    static void forEachSegment(Function&& function)
+    {
+        for(double x = -2.0; x <= 2.0; x += 1.0 / 128.0)
+            for(double width = 1e-6; width <= 1.0; width *= 1.25)
+                for(double direction : { -1.0, 1.0 })
+                {
+                    const float x0 = (float) x;
+                    const float x1 = (float) (x + direction * width);
+
+                    if(x1 != x0)
+                        function(x0, x1);
+                }
+    }
+
+    /**
+     * Averages a shaper over a segment with its antiderivative.
+     * @param x0 The start of the segment.
+     * @param x1 The end of the segment.
+     * @param antiderivative The antiderivative of the shaper.
+     * @param shaper The shaper, used for empty segments.
+     * @returns The average of the shaper over the segment.
+     */
+    template <typename Antiderivative, typename Shaper>
+    static double average(double x0, double x1, Antiderivative&& antiderivative, Shaper&& shaper)
+    {
+        if(x0 == x1)
+            return shaper(x0);
+
+        return (antiderivative(x1) - antiderivative(x0)) / (x1 - x0);
+    }
+
+    /** The reference arctangent square root shaper, which clips its argument at |0.9x| = 1. */
+    static double atsr(double x)
+    {
+        const double y = jlimit(-1.0, 1.0, 0.9 * x);
+        return 2.5 * std::atan(y) + 2.5 * std::sqrt(1.0 - y * y) - 2.5;
+    }
+
+    /** The reference antiderivative of `atsr()`, continued linearly past the clipping. */
+    static double atsrAntiderivative(double x)
+    {
+        const double y = jlimit(-1.0, 1.0, 0.9 * x);
+        const double integral = y * std::atan(y) - 0.5 * std::log(1.0 + y * y) + 0.5 * (y * std::sqrt(1.0 - y * y) + std::asin(y));
+
+        return (2.5 / 0.9) * integral - 2.5 * y / 0.9 + atsr(x) * (x - y / 0.9);
+    }
+
+    /** The reference hyperbolic tangent shaper. */
+    static double htan(double k, double x)
+    {
+        return std::tanh((k * 17.0 + 1.0) * x);
+    }
+
+    /** The reference antiderivative of `htan()`. */
+    static double htanAntiderivative(double k, double x)
+    {
+        const double a = k * 17.0 + 1.0;
+        return std::log(std::cosh(a * x)) / a;
+    }
+
+    /** The waveshaper under test. */
+    PhantomWaveshaper m_waveshaper;
+
+    /** The bound of the error of the plain shapers. */
+    const double k_maxShaperError = 3e-6;
+
+    /** The bound of the error of `atsr()`, which is ill-conditioned next to its clipping. */
+    const double k_maxAtsrError = 1.5e-5;
+
+    /**
+     * The bound of the error of the anti-aliased shapers, which is set by rounding the
+     * antiderivatives to floats for segments just wider than the ill-conditioned tolerance
+     * (see `PhantomWaveshaper.h`).
+     */
+    const double k_maxADAAError = 1.5e-3;
+};
+
+static PhantomWaveshaperTests phantomWaveshaperTests;
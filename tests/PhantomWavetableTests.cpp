@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    PhantomWavetableTests.cpp
+    Created: 18 Oct 2026 10:15:00
+    Author:  Matthew Maxwell
+
+  ==============================================================================
+*/
+
+#include "JuceHeader.h"
+
+#include "../src/generators/PhantomWavetable.h"
+
+/**
+ * Bounds the aliasing of the wavetable reads, for every phasor shape and a range of distortion
+ * amounts and pitches, at the mipmap level `getLevel()` picks for the pitch.
+ */
+class PhantomWavetableTests : public UnitTest
+{
+public:
+    PhantomWavetableTests() : UnitTest("PhantomWavetable", "Phantom") {}
+
+    void runTest() override
+    {
+        /**
+         * NOTE: Each pitch is rounded to an odd number of cycles per block, so the harmonics fall
+         * exactly on bins that are multiples of it, while anything folded back from above Nyquist
+         * falls between them (the block size is a power of two). The power outside the harmonic
+         * bins is then the aliasing, plus the images of the table interpolation.
+         */
+        beginTest("aliasing");
+        {
+            double maxAliasing = -std::numeric_limits<double>::infinity();
+            double worstFrequency = 0.0;
+
+            for(double sampleRate : { 44100.0, 48000.0 })
+                for(int note = 21; note <= 108; note += 3)
+                {
+                    const double frequency = 440.0 * std::pow(2.0, (note - 69) / 12.0);
+                    const int numCycles = (int) (frequency * k_blockSize / sampleRate) | 1;
+
+                    for(int shape = 0; shape < PhantomPhasor::getNumShapes(); shape++)
+                        for(float amount : { 0.0f, 0.3f, 1.0f })
+                        {
+                            const double aliasing = measureAliasing(getWavetable(shape), numCycles, amount);
+
+                            if(aliasing > maxAliasing)
+                            {
+                                maxAliasing = aliasing;
+                                worstFrequency = numCycles * sampleRate / k_blockSize;
+                            }
+                        }
+                }
+
+            logMessage("Max aliasing: " + String(maxAliasing, 1) + " dB (at " + String(worstFrequency, 1) + " Hz)");
+            expectLessThan(maxAliasing, k_maxAliasing, "aliasing");
+        }
+    }
+
+private:
+    /**
+     * @param shape The phasor shape.
+     * @returns The wavetable of the phasor shape, built on first use.
+     */
+    const PhantomWavetable& getWavetable(int shape)
+    {
+        while(m_wavetables.size() <= shape)
+            m_wavetables.add(new PhantomWavetable(PhantomPhasor::getWarpCurve(m_wavetables.size()), 1.0f));
+
+        return *m_wavetables[shape];
+    }
+
+    /**
+     * Reads a block of a wavetable at a fixed pitch and measures the power between its harmonics.
+     * @param wavetable The wavetable to read.
+     * @param numCycles The number of cycles in the block (odd).
+     * @param amount The phase distortion amount.
+     * @returns The power between the harmonics relative to the total power (dB).
+     */
+    static double measureAliasing(const PhantomWavetable& wavetable, int numCycles, float amount)
+    {
+        HeapBlock<float> samples((size_t) (2 * k_blockSize), true);
+        HeapBlock<float> amounts((size_t) k_blockSize);
+
+        for(int i = 0; i < k_blockSize; i++)
+        {
+            samples[i] = (float) ((int64) i * numCycles % k_blockSize) / (float) k_blockSize;
+            amounts[i] = amount;
+        }
+
+        const float level = wavetable.getLevel((float) numCycles / (float) k_blockSize);
+        wavetable.process(samples.get(), samples.get(), amounts.get(), level, level, k_blockSize, PhantomWavetable::CUBIC);
+
+        dsp::FFT fft(k_fftOrder);
+        fft.performRealOnlyForwardTransform(samples.get());
+
+        double harmonicPower = 0.0;
+        double aliasPower = 0.0;
+
+        for(int bin = 1; bin <= k_blockSize / 2; bin++)
+        {
+            const double power = (double) samples[2 * bin] * samples[2 * bin] + (double) samples[2 * bin + 1] * samples[2 * bin + 1];
+
+            if(bin % numCycles == 0)
+                harmonicPower += power;
+            else
+                aliasPower += power;
+        }
+
+        return 10.0 * std::log10(jmax(aliasPower, 1e-30) / harmonicPower);
+    }
+
+    /** The wavetables of the phasor shapes. */
+    OwnedArray<PhantomWavetable> m_wavetables;
+
+    /** The FFT order of the measured blocks. */
+    static constexpr int k_fftOrder = 12;
+
+    /** The number of samples in the measured blocks. */
+    static constexpr int k_blockSize = 1 << k_fftOrder;
+
+    /**
+     * The bound of the power between the harmonics (dB), which is set by the images of the
+     * cubic interpolation (-66.5 dB at most). Reading the level below the one `getLevel()` picks,
+     * whose highest harmonics are above Nyquist, measures -20 to -35 dB for the distorted shapes.
+     */
+    const double k_maxAliasing = -60.0;
+};
+
+static PhantomWavetableTests phantomWavetableTests;